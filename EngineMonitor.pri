@@ -0,0 +1,110 @@
+########################################################################
+#                                                                      #
+# EngineMonitor, a graphical gauge to monitor an aircraft's engine     #
+# Copyright (C) 2017 Ryan Story                                        #
+#                                                                      #
+# This program is free software: you can redistribute it and/or modify #
+# it under the terms of the GNU General Public License as published by #
+# the Free Software Foundation, either version 3 of the License, or    #
+# (at your option) any later version.                                  #
+#                                                                      #
+# This program is distributed in the hope that it will be useful,      #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of       #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        #
+# GNU General Public License for more details.                         #
+#                                                                      #
+# You should have received a copy of the GNU General Public License    #
+# along with this program. If not, see <http://www.gnu.org/licenses/>. #
+#                                                                      #
+########################################################################
+
+# Everything of the application except main(), shared with the benchmarks that build the
+# real EngineMonitor scene
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/enginemonitor.cpp \
+    $$PWD/bargraph.cpp \
+    $$PWD/rpmindicator.cpp \
+    $$PWD/cylinderheadtemperature.cpp \
+    $$PWD/exhaustgastemperature.cpp \
+    $$PWD/fuelmanagement.cpp \
+    $$PWD/rdacconnect.cpp \
+    $$PWD/rdacparser.cpp \
+    $$PWD/rdaclinkstats.cpp \
+    $$PWD/rdaccapture.cpp \
+    $$PWD/rdacreplay.cpp \
+    $$PWD/rdacprobe.cpp \
+    $$PWD/nmeaconnect.cpp \
+    $$PWD/manifoldpressure.cpp \
+    $$PWD/sensorconvert.cpp \
+    $$PWD/framescheduler.cpp \
+    $$PWD/gaugecache.cpp \
+    $$PWD/readouttext.cpp \
+    $$PWD/paintprofiler.cpp \
+    $$PWD/trendbuffer.cpp \
+    $$PWD/trendpyramid.cpp \
+    $$PWD/flightlog.cpp \
+    $$PWD/alarmengine.cpp \
+    $$PWD/arduinoparser.cpp \
+    $$PWD/thermocouple.cpp \
+    $$PWD/calibration.cpp \
+    $$PWD/circulargauge.cpp \
+    $$PWD/alarmBox.cpp \
+    $$PWD/textBoxGauge.cpp \
+    $$PWD/fueldisplay.cpp \
+    $$PWD/chtegtgauge.cpp \
+    $$PWD/buttonbar.cpp \
+    $$PWD/qcustomplot/qcustomplot.cpp \
+    $$PWD/udpsocket.cpp \
+    $$PWD/flightcalculator.cpp \
+    $$PWD/windvector.cpp \
+    $$PWD/hourmeter.cpp \
+    $$PWD/spatial.cpp \
+    $$PWD/gaugesettings.cpp
+
+HEADERS += $$PWD/enginemonitor.h \
+    $$PWD/bargraph.h \
+    $$PWD/rpmindicator.h \
+    $$PWD/cylinderheadtemperature.h \
+    $$PWD/exhaustgastemperature.h \
+    $$PWD/fuelmanagement.h \
+    $$PWD/rdacconnect.h \
+    $$PWD/rdacparser.h \
+    $$PWD/rdacprotocol.h \
+    $$PWD/rdaclinkstats.h \
+    $$PWD/rdaccapture.h \
+    $$PWD/rdacreplay.h \
+    $$PWD/rdacprobe.h \
+    $$PWD/spscqueue.h \
+    $$PWD/nmeaconnect.h \
+    $$PWD/manifoldpressure.h \
+    $$PWD/sensorconvert.h \
+    $$PWD/framescheduler.h \
+    $$PWD/gaugecache.h \
+    $$PWD/readouttext.h \
+    $$PWD/paintprofiler.h \
+    $$PWD/trendbuffer.h \
+    $$PWD/trendpyramid.h \
+    $$PWD/flightlog.h \
+    $$PWD/alarmengine.h \
+    $$PWD/arduinoparser.h \
+    $$PWD/arduinoprotocol.h \
+    $$PWD/enginesample.h \
+    $$PWD/thermocouple.h \
+    $$PWD/calibration.h \
+    $$PWD/units.h \
+    $$PWD/circulargauge.h \
+    $$PWD/alarmBox.h \
+    $$PWD/textBoxGauge.h \
+    $$PWD/fueldisplay.h \
+    $$PWD/chtegtgauge.h \
+    $$PWD/buttonbar.h \
+    $$PWD/qcustomplot/qcustomplot.h \
+    $$PWD/udpsocket.h \
+    $$PWD/flightcalculator.h \
+    $$PWD/windvector.h \
+    $$PWD/hourmeter.h \
+    $$PWD/spatial.h \
+    $$PWD/gaugesettings.h
@@ -37,54 +37,9 @@ Debug:UI_DIR = debug/.ui
 
 RC_FILE = ./res/icon.rc
 
-SOURCES += main.cpp\
-    enginemonitor.cpp \
-    bargraph.cpp \
-    rpmindicator.cpp \
-    cylinderheadtemperature.cpp \
-    exhaustgastemperature.cpp \
-    fuelmanagement.cpp \
-    rdacconnect.cpp \
-    nmeaconnect.cpp \
-    manifoldpressure.cpp \
-    sensorconvert.cpp \
-    circulargauge.cpp \
-    alarmBox.cpp \
-    textBoxGauge.cpp \
-    fueldisplay.cpp \
-    chtegtgauge.cpp \
-    buttonbar.cpp \
-    qcustomplot/qcustomplot.cpp \
-    udpsocket.cpp \
-    flightcalculator.cpp \
-    windvector.cpp \
-    hourmeter.cpp \
-    spatial.cpp \
-    gaugesettings.cpp
+SOURCES += main.cpp
 
-HEADERS  += enginemonitor.h \
-    bargraph.h \
-    rpmindicator.h \
-    cylinderheadtemperature.h \
-    exhaustgastemperature.h \
-    fuelmanagement.h \
-    rdacconnect.h \
-    nmeaconnect.h \
-    manifoldpressure.h \
-    sensorconvert.h \
-    circulargauge.h \
-    alarmBox.h \
-    textBoxGauge.h \
-    fueldisplay.h \
-    chtegtgauge.h \
-    buttonbar.h \
-    qcustomplot/qcustomplot.h \
-    udpsocket.h \
-    flightcalculator.h \
-    windvector.h \
-    hourmeter.h \
-    spatial.h \
-    gaugesettings.h
+include(EngineMonitor.pri)
 
 RESOURCES += \
     res/res.qrc
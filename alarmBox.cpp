@@ -19,6 +19,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "alarmBox.h"
+#include "paintprofiler.h"
 
 AlarmBox::AlarmBox(QGraphicsObject *parent) : QGraphicsObject(parent)
 {
@@ -43,6 +44,7 @@ QRectF AlarmBox::boundingRect() const
 */
 void AlarmBox::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+    PaintProfiler::Scope profile(this);
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
@@ -100,9 +102,6 @@ void AlarmBox::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
             painter->drawText(QRectF(boundingX + 2, boundingY + 23 + (22 * i), boundingWidth - 4, 20), Qt::AlignCenter, alarmText[i]);
         }
     }
-
-    //  Update the item. Without this, the program will wait for something else to cause a redraw
-    update();
 }
 
 /*! \brief
@@ -143,6 +142,9 @@ void AlarmBox::onRemoveAlarm(QString text)
 
     }
 
+    if (itemFound) {
+        update();
+    }
 }
 
 /*! \brief Slot called when the AlarmBox receives an alarm signal.
@@ -179,6 +181,14 @@ void AlarmBox::changeFlashState()
     } else {
         flashState = false;
     }
+
+    //  Only alarms that are still flashing look different in the new phase
+    for (int i = 0; i <= 9; i++) {
+        if (alarmText[i] != "" && alarmFlash[i] == true) {
+            update();
+            break;
+        }
+    }
 }
 
 void AlarmBox::onAlarmAck() {
@@ -188,5 +198,6 @@ void AlarmBox::onAlarmAck() {
         }
     }
 
+    update();
     emit stopAlarmFlash();
 }
@@ -0,0 +1,203 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "alarmengine.h"
+
+AlarmEngine::AlarmEngine(QObject *parent) : QObject(parent)
+  , isWarmup(true)
+{
+	for(int i = 0; i < ChannelCount; ++i)
+	{
+		channelLevels[i] = AlarmNone;
+	}
+
+	QSettings settings("settings/settings.ini", QSettings::IniFormat);
+	latch = settings.value("Alarms/latch", false).toBool();
+}
+
+/*! \brief Adds an alarm source for a gauge and returns its index
+*
+* gaugeName is the group of the ranges in gaugeSettings.ini, title is the text in the alarm
+* window. The channels firstChannel to firstChannel + channelCount - 1 are classified together.
+* With warnBeyondScale every value below the minimum or above the maximum of the scale is a warning.
+*/
+int AlarmEngine::addSource(QString title, QString gaugeName, EngineChannel firstChannel, int channelCount, bool announce, bool warnBeyondScale)
+{
+	AlarmSource source;
+	source.title = title;
+	source.gauge = new GaugeSettings(this);
+	source.gauge->setGauge(gaugeName);
+	source.firstChannel = firstChannel;
+	source.channelCount = channelCount;
+	source.announce = announce;
+	source.warnBeyondScale = warnBeyondScale;
+	source.minimum = source.gauge->getMin();
+	source.maximum = source.gauge->getMax();
+	QSettings gaugeSettings("settings/gaugeSettings.ini", QSettings::IniFormat);
+	source.hysteresis = gaugeSettings.value(gaugeName + "/hysteresis", (source.maximum - source.minimum) * 0.01).toDouble();
+	source.level = AlarmNone;
+	source.shown = AlarmNone;
+	source.acknowledged = false;
+	sources.append(source);
+	return sources.size() - 1;
+}
+
+AlarmState AlarmEngine::sourceState(int source) const
+{
+	const AlarmSource &s = sources.at(source);
+	AlarmState state = {s.shown, s.acknowledged};
+	return state;
+}
+
+QColor AlarmEngine::levelColor(AlarmLevel level)
+{
+	return level == AlarmWarning ? QColor(Qt::red) : level == AlarmCaution ? QColor(Qt::yellow) : QColor(Qt::green);
+}
+
+/*! \brief Returns the level of the range the value is in
+*
+* Values beyond the scale are a warning for sources added with warnBeyondScale, otherwise they
+* take the level of the outermost range if it reaches the end of the scale.
+*/
+AlarmLevel AlarmEngine::classify(const AlarmSource &source, qreal value) const
+{
+	if(source.warnBeyondScale && (value > source.maximum || value < source.minimum))
+	{
+		return AlarmWarning;
+	}
+
+	const GaugeSettings &gauge = *source.gauge;
+	const std::vector<GaugeSettings::gaugeDef> &ranges = (isWarmup && !gauge.warmupDefinitions.empty()) ? gauge.warmupDefinitions : gauge.definitions;
+	if(ranges.empty())
+	{
+		return AlarmNone;
+	}
+
+	const GaugeSettings::gaugeDef *range = Q_NULLPTR;
+	if(value < ranges.front().start && ranges.front().start == source.minimum)
+	{
+		range = &ranges.front();
+	}
+	else if(value >= ranges.back().end && ranges.back().end == source.maximum)
+	{
+		range = &ranges.back();
+	}
+	else
+	{
+		for(size_t i = 0; i < ranges.size(); ++i)
+		{
+			if(value >= ranges[i].start && value < ranges[i].end)
+			{
+				range = &ranges[i];
+			}
+		}
+	}
+
+	if(!range)
+	{
+		return AlarmNone;
+	}
+	return range->color == Qt::red ? AlarmWarning : range->color == Qt::yellow ? AlarmCaution : AlarmNone;
+}
+
+/*! \brief Classifies all valid channels of the sample and publishes the changes
+*/
+void AlarmEngine::processSample(const EngineSample &sample)
+{
+	for(int index = 0; index < sources.size(); ++index)
+	{
+		const AlarmSource &source = sources.at(index);
+		AlarmLevel worst = AlarmNone;
+		bool channelsChanged = false;
+		for(int c = source.firstChannel; c < source.firstChannel + source.channelCount; ++c)
+		{
+			const EngineChannel channel = EngineChannel(c);
+			if(sample.isValid(channel))
+			{
+				const qreal value = sample.value[channel];
+				const AlarmLevel level = classify(source, value);
+				// Stay at a higher level while the value is within the hysteresis of its range
+				const AlarmLevel nearby = qMax(classify(source, value - source.hysteresis), classify(source, value + source.hysteresis));
+				const AlarmLevel newLevel = qMax(level, qMin(channelLevels[channel], nearby));
+				if(newLevel != channelLevels[channel])
+				{
+					channelLevels[channel] = newLevel;
+					channelsChanged = true;
+				}
+			}
+			worst = qMax(worst, channelLevels[channel]);
+		}
+
+		AlarmSource &s = sources[index];
+		if(worst > s.level)
+		{
+			s.acknowledged = false;
+		}
+		s.level = worst;
+		publish(index, (latch && !s.acknowledged) ? qMax(worst, s.shown) : worst, channelsChanged);
+	}
+}
+
+void AlarmEngine::setWarmup(bool warmup)
+{
+	isWarmup = warmup;
+}
+
+/*! \brief Acknowledges all alarms, latched alarms whose value is back to normal are cleared
+*/
+void AlarmEngine::acknowledge()
+{
+	for(int index = 0; index < sources.size(); ++index)
+	{
+		AlarmSource &s = sources[index];
+		if(s.shown != AlarmNone && !s.acknowledged)
+		{
+			s.acknowledged = true;
+			publish(index, s.level, true);
+		}
+	}
+}
+
+void AlarmEngine::publish(int source, AlarmLevel shown, bool channelsChanged)
+{
+	AlarmSource &s = sources[source];
+	const AlarmLevel previous = s.shown;
+	s.shown = shown;
+	if(shown == AlarmNone)
+	{
+		s.acknowledged = false;
+	}
+
+	if(shown != previous && s.announce)
+	{
+		if(previous != AlarmNone)
+		{
+			emit cancelAlarm(s.title);
+		}
+		if(shown != AlarmNone)
+		{
+			emit sendAlarm(s.title, levelColor(shown), !s.acknowledged);
+		}
+	}
+	if(shown != previous || channelsChanged)
+	{
+		emit alarmStateChanged(source);
+	}
+}
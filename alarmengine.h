@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ALARMENGINE_H
+#define ALARMENGINE_H
+
+#include <QtCore>
+#include <QtGui>
+#include "enginesample.h"
+#include "gaugesettings.h"
+
+enum AlarmLevel {
+	AlarmNone,
+	AlarmCaution, // Yellow range
+	AlarmWarning  // Red range
+};
+
+//! Alarm State
+/*!
+ * What a gauge shows for an alarm source. A latched alarm keeps its level until it is
+ * acknowledged, even if the value already returned to a normal range.
+*/
+
+struct AlarmState
+{
+	AlarmLevel level;
+	bool acknowledged;
+};
+
+//! Alarm Engine Class
+/*!
+ * This class classifies every engine sample against the ranges of the gauge settings as soon as
+ * it arrives. Each alarm source is one gauge and covers one or more channels; its level is the
+ * worst level of its channels. A channel only drops to a lower level once its value is more than
+ * the hysteresis (<gauge>/hysteresis, 1% of the scale by default) away from the higher range.
+ * Only changes are published, the alarm window gets sendAlarm()/cancelAlarm() and the gauges
+ * read the precomputed state on alarmStateChanged().
+*/
+
+class AlarmEngine : public QObject
+{
+	Q_OBJECT
+public:
+	explicit AlarmEngine(QObject *parent = 0);
+	int addSource(QString title, QString gaugeName, EngineChannel firstChannel, int channelCount = 1, bool announce = true, bool warnBeyondScale = false);
+	AlarmState sourceState(int source) const;
+	AlarmLevel channelLevel(EngineChannel channel) const {return channelLevels[channel];}
+	static QColor levelColor(AlarmLevel level);
+public slots:
+	void processSample(const EngineSample &sample);
+	void setWarmup(bool warmup);
+	void acknowledge();
+signals:
+	void sendAlarm(QString, QColor, bool);
+	void cancelAlarm(QString);
+	void alarmStateChanged(int source);
+private:
+	struct AlarmSource
+	{
+		QString title;
+		GaugeSettings *gauge;
+		EngineChannel firstChannel;
+		int channelCount;
+		bool announce; // Show in the alarm window
+		bool warnBeyondScale; // Values outside the scale are a warning, whatever the ranges say
+		qreal minimum, maximum; // Scale of the gauge
+		qreal hysteresis;
+		AlarmLevel level; // Current worst level of the channels
+		AlarmLevel shown; // Level shown, includes a latched level
+		bool acknowledged;
+	};
+	AlarmLevel classify(const AlarmSource &source, qreal value) const;
+	void publish(int source, AlarmLevel shown, bool channelsChanged);
+	QVector<AlarmSource> sources;
+	AlarmLevel channelLevels[ChannelCount];
+	bool isWarmup;
+	bool latch;
+};
+
+#endif // ALARMENGINE_H
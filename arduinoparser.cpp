@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "arduinoparser.h"
+
+ArduinoParser::ArduinoParser() : count(0)
+  , overflow(false)
+  , rejected(0)
+{
+	for(int i = 0; i < ArduinoFieldCount; ++i)
+	{
+		value[i] = 0.0;
+	}
+}
+
+void ArduinoParser::clear()
+{
+	count = 0;
+	overflow = false;
+}
+
+/*! \brief Consumes received bytes up to and including the next frame delimiter
+*
+* Advances data behind the consumed bytes. Returns arduinoResultMessageIncomplete once all bytes
+* up to end are buffered, otherwise the result for the frame that just ended, whose fields are
+* then available through values().
+*/
+ArduinoParser::arduinoResults ArduinoParser::feed(const char *&data, const char *end)
+{
+	while(data < end)
+	{
+		const quint8 byte = quint8(*data++);
+		if(byte == 0x00)
+		{
+			const arduinoResults result = overflow ? arduinoResultMessageInvalidEncoding : decodeFrame();
+			clear();
+			if(result != arduinoResultMessageComplete)
+			{
+				++rejected;
+			}
+			return result;
+		}
+		if(count < ArduinoMaxEncodedLength)
+		{
+			buffer[count++] = byte;
+		}
+		else
+		{
+			overflow = true;
+		}
+	}
+	return arduinoResultMessageIncomplete;
+}
+
+/*! \brief Decodes the buffered COBS frame in place and extracts its fields
+*/
+ArduinoParser::arduinoResults ArduinoParser::decodeFrame()
+{
+	int length = 0;
+	int index = 0;
+	while(index < count)
+	{
+		const int code = buffer[index++];
+		if(index + code - 1 > count)
+		{
+			return arduinoResultMessageInvalidEncoding;
+		}
+		for(int i = 1; i < code; ++i)
+		{
+			buffer[length++] = buffer[index++];
+		}
+		if(code < 0xFF && index < count)
+		{
+			buffer[length++] = 0x00;
+		}
+	}
+
+	const RDACmessageDescriptor &descriptor = arduinoSensorMessage;
+	if(length != descriptor.length)
+	{
+		return arduinoResultMessageInvalidEncoding;
+	}
+	const quint16 crc = quint16(buffer[length - 2] | (buffer[length - 1] << 8));
+	if(crc != crc16(buffer, length - 2))
+	{
+		return arduinoResultMessageInvalidChecksum;
+	}
+	if(buffer[0] != descriptor.type)
+	{
+		return arduinoResultMessageIllegalDatatype;
+	}
+	rdacDecodeFields(descriptor, buffer + descriptor.payloadOffset, value);
+	return arduinoResultMessageComplete;
+}
+
+/*! \brief CRC-16/CCITT, polynomial 0x1021 and initial value 0xFFFF
+*/
+quint16 ArduinoParser::crc16(const quint8 *data, int length)
+{
+	quint16 crc = 0xFFFF;
+	for(int i = 0; i < length; ++i)
+	{
+		crc ^= quint16(data[i] << 8);
+		for(int bit = 0; bit < 8; ++bit)
+		{
+			crc = (crc & 0x8000) ? quint16((crc << 1) ^ 0x1021) : quint16(crc << 1);
+		}
+	}
+	return crc;
+}
+
+/*! \brief COBS encodes a frame, as the sensor interface does, and appends the delimiter
+*
+* The encoded buffer needs room for length + length / 254 + 2 bytes. Returns the encoded size.
+*/
+int ArduinoParser::encode(const quint8 *frame, int length, quint8 *encoded)
+{
+	int codeIndex = 0;
+	int size = 1;
+	quint8 code = 1;
+	for(int i = 0; i < length; ++i)
+	{
+		if(frame[i] != 0x00)
+		{
+			encoded[size++] = frame[i];
+			++code;
+		}
+		if(frame[i] == 0x00 || code == 0xFF)
+		{
+			encoded[codeIndex] = code;
+			codeIndex = size++;
+			code = 1;
+		}
+	}
+	encoded[codeIndex] = code;
+	encoded[size++] = 0x00;
+	return size;
+}
@@ -0,0 +1,61 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ARDUINOPARSER_H
+#define ARDUINOPARSER_H
+
+#include <QtCore>
+#include "arduinoprotocol.h"
+
+//! Arduino Parser Class
+/*!
+ * This class frames and decodes the binary protocol of the Arduino sensor interface. Bytes are
+ * collected up to the zero delimiter in a fixed buffer, then the frame is COBS decoded in place,
+ * its CRC verified and its fields scaled by the descriptor. An overlong or damaged frame is
+ * dropped at the next delimiter, nothing is allocated.
+*/
+
+class ArduinoParser
+{
+public:
+	ArduinoParser();
+	enum arduinoResults {
+		arduinoResultMessageComplete,
+		arduinoResultMessageIncomplete,
+		arduinoResultMessageInvalidEncoding,
+		arduinoResultMessageInvalidChecksum,
+		arduinoResultMessageIllegalDatatype
+	};
+	arduinoResults feed(const char *&data, const char *end);
+	const qreal *values() const {return value;}
+	quint32 framesRejected() const {return rejected;}
+	void clear();
+	static quint16 crc16(const quint8 *data, int length);
+	static int encode(const quint8 *frame, int length, quint8 *encoded);
+private:
+	arduinoResults decodeFrame();
+	quint8 buffer[ArduinoMaxEncodedLength];
+	int count;
+	bool overflow;
+	quint32 rejected;
+	qreal value[ArduinoFieldCount];
+};
+
+#endif // ARDUINOPARSER_H
@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ARDUINOPROTOCOL_H
+#define ARDUINOPROTOCOL_H
+
+#include <QtCore>
+#include "rdacprotocol.h"
+
+//! Arduino Binary Protocol Description
+/*!
+ * Optional binary replacement for the comma separated data string of the Arduino sensor
+ * interface, selected with Sensors/interface=arduinobinary. A frame carries the message type,
+ * the same sixteen channels as the data string as little endian 16 bit fixed point words and a
+ * CRC-16/CCITT over both, sent low byte first. The frame is COBS encoded so it contains no zero
+ * bytes and is terminated by a single zero, which makes resyncing trivial. Fields are described
+ * with the RDAC descriptors and decoded by the same code.
+*/
+
+enum ArduinoField {
+	ArduinoRpm,
+	ArduinoFuelFlow,
+	ArduinoOilTemp,
+	ArduinoOilPress,
+	ArduinoAmps,
+	ArduinoVolts,
+	ArduinoEgt1,
+	ArduinoEgt4 = ArduinoEgt1 + 3,
+	ArduinoCht1,
+	ArduinoCht4 = ArduinoCht1 + 3,
+	ArduinoOat,
+	ArduinoIat,
+	ArduinoFieldCount
+};
+
+// Same units as the data string, signed values are sent offset binary
+static Q_DECL_CONSTEXPR RDACfieldDescriptor arduinoSensorFields[] = {
+	{"rpm",           0, 1.0,     0.0},     // Pulses per minute
+	{"fuelFlow",      2, 16.0,    0.0},     // Pulses per hour
+	{"oilTemp",       4, 0.1,     0.0},     // Ohm
+	{"oilPress",      6, 0.0001,  0.0},     // Volt
+	{"amps",          8, 0.01,    -327.68}, // Ampere
+	{"volts",        10, 0.001,   0.0},     // Volt
+	{"egt1",         12, 1e-6,    -0.01},   // Volt
+	{"egt2",         14, 1e-6,    -0.01},
+	{"egt3",         16, 1e-6,    -0.01},
+	{"egt4",         18, 1e-6,    -0.01},
+	{"cht1",         20, 1e-6,    -0.01},
+	{"cht2",         22, 1e-6,    -0.01},
+	{"cht3",         24, 1e-6,    -0.01},
+	{"cht4",         26, 1e-6,    -0.01},
+	{"oat",          28, 0.01,    -327.68}, // Degree C
+	{"iat",          30, 0.01,    -327.68}  // Degree C
+};
+
+// Length is the decoded frame: type, payload and CRC
+static Q_DECL_CONSTEXPR RDACmessageDescriptor arduinoSensorMessage = {0x01, 35, 1, ArduinoFieldCount, arduinoSensorFields};
+
+enum {
+	ArduinoMaxFrameLength = 35,
+	ArduinoMaxEncodedLength = ArduinoMaxFrameLength + ArduinoMaxFrameLength / 254 + 1
+};
+
+Q_STATIC_ASSERT(sizeof(arduinoSensorFields) / sizeof(RDACfieldDescriptor) == ArduinoFieldCount);
+Q_STATIC_ASSERT(arduinoSensorMessage.payloadOffset + 2 * ArduinoFieldCount + 2 == arduinoSensorMessage.length);
+Q_STATIC_ASSERT(ArduinoFieldCount == 16);
+
+#endif // ARDUINOPROTOCOL_H
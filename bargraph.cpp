@@ -19,6 +19,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "bargraph.h"
+#include "paintprofiler.h"
 
 BarGraph::BarGraph(QGraphicsObject *parent)
 	: QGraphicsObject(parent)
@@ -30,6 +31,12 @@ BarGraph::BarGraph(QGraphicsObject *parent)
 	, barPrecision(0)
 	, readoutPrecision(0)
 {
+	//Readout font, laid out once per value instead of on every paint
+	QFont readoutFont;
+	readoutFont.setBold(true);
+	readoutFont.setPointSize(18);
+	valueReadout.setFont(readoutFont);
+	valueReadout.setValue(currentValue);
 
 }
 
@@ -38,15 +45,10 @@ QRectF BarGraph::boundingRect() const
     return QRectF(-45, -75, 85, 160);
 }
 
-/*! \brief Handles drawing of the object
-*
-* This member handles all of the painting logic used to draw the item and the associated style.
+/*! \brief Draws the bar, its ranges, title and unit, which are cached by paint()
 */
-void BarGraph::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+void BarGraph::paintBackground(QPainter *painter)
 {
-	Q_UNUSED(option);
-	Q_UNUSED(widget);
-
 	//Save thje painter and deactivate Antialising for rectangle drawing
 	painter->save();
 	painter->setRenderHint(QPainter::Antialiasing, false);
@@ -79,8 +81,6 @@ void BarGraph::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
     //Restore the painter with antialising
     painter->restore();
 
-    isPenAlarmColored = false;
-
     if (gauge.getName() != "") {
         i=0;
         numOfRanges = gauge.getNRange();
@@ -107,80 +107,32 @@ void BarGraph::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 
             //Restore the painter with antialising
             painter->restore();
-
-            if (currentValue >= start && currentValue < end) {
-                if (color == Qt::red) {
-                    if (isAlarmedRed == false) {
-                        emit sendAlarm(titleText, color, true);
-                    }
-
-                    isAlarmedRed = true;
-                    isAlarmedYellow = false;
-                    isPenAlarmColored = true;
-
-                } else if (color == Qt::yellow) {
-                    if (isAlarmedYellow == false) {
-                        emit sendAlarm(titleText, color, true);
-                    }
-
-                    isAlarmedRed = false;
-                    isAlarmedYellow = true;
-                    isPenAlarmColored = true;
-
-                }
-            }
-        }
-    }
-
-    if (currentValue < minValue) {
-        if (minValue == gauge.definitions[0].start) {
-            color = gauge.definitions[0].color;
-
-            if (color == Qt::yellow) {
-                isPenAlarmColored = true;
-                isAlarmedYellow = true;
-                isAlarmedRed = false;
-            } else if (color == Qt::red) {
-                isPenAlarmColored = true;
-                isAlarmedRed = true;
-                isAlarmedYellow = false;
-            }
         }
-    } else if (currentValue > maxValue) {
-        if (numOfRanges > 0) {
-            if (maxValue == gauge.definitions[numOfRanges-1].end) {
-                color = gauge.definitions[numOfRanges-1].color;
-
-                if (color == Qt::yellow) {
-                    if(isAlarmedYellow == false) {
-                        emit sendAlarm(titleText, Qt::yellow, true);
-                    }
-                    isPenAlarmColored = true;
-                    isAlarmedYellow = true;
-                    isAlarmedRed = false;
-
-                } else if (color == Qt::red) {
-                    if(isAlarmedRed == false) {
-                        emit sendAlarm(titleText, Qt::red, true);
-                    }
-                    isPenAlarmColored = true;
-                    isAlarmedRed = true;
-                    isAlarmedYellow = false;
-                }
-            }
-        }
-
     }
 
     //Draw Texts around (title, min and max value)
     painter->setPen(Qt::white);
     painter->drawText(QRectF(-25, calculateLocalValue(maxValue)-35, 50, 15), Qt::AlignCenter,titleText);
     painter->drawText(QRectF(-25, calculateLocalValue(maxValue)-20, 50, 15), Qt::AlignCenter,unitText);
+}
 
-    //Set readout details
-    font.setBold(true);
-    font.setPointSize(18);
-    painter->setFont(font);
+/*! \brief Handles drawing of the object
+*
+* This member handles all of the painting logic used to draw the item and the associated style.
+*/
+void BarGraph::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+	PaintProfiler::Scope profile(this);
+	Q_UNUSED(option);
+	Q_UNUSED(widget);
+
+    //Draw the static layer from the cache, it only changes with the configuration
+    if (!backgroundCache.isValid(painter)) {
+        QPainter cachePainter;
+        backgroundCache.beginUpdate(&cachePainter, painter, boundingRect());
+        paintBackground(&cachePainter);
+    }
+    backgroundCache.draw(painter);
 
     if (isAlarmedRed) {
         if (flashState || isAcknowledged) {
@@ -188,11 +140,11 @@ void BarGraph::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
             painter->setBrush(Qt::red);
             painter->drawRect(QRectF(-30, 55, 60, 22));
             painter->setPen(Qt::white);
-            painter->drawText(QRectF(-30, 55, 60, 20), Qt::AlignCenter, QString::number(currentValue, 'f', readoutPrecision));
+            valueReadout.draw(painter, QRectF(-30, 55, 60, 20));
 
          } else {
             painter->setPen(Qt::red);
-            painter->drawText(QRectF(-30, 55, 60, 22), Qt::AlignCenter, QString::number(currentValue, 'f', readoutPrecision));
+            valueReadout.draw(painter, QRectF(-30, 55, 60, 22));
         }
     } else if (isAlarmedYellow) {
         if (flashState || isAcknowledged) {
@@ -200,24 +152,15 @@ void BarGraph::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
             painter->setBrush(Qt::yellow);
             painter->drawRect(QRectF(-30, 55, 60, 22));
             painter->setPen(Qt::black);
-            painter->drawText(QRectF(-30, 55, 60, 22), Qt::AlignCenter, QString::number(currentValue, 'f', readoutPrecision));
+            valueReadout.draw(painter, QRectF(-30, 55, 60, 22));
 
          } else {
             painter->setPen(Qt::yellow);
-            painter->drawText(QRectF(-30, 55, 60, 22), Qt::AlignCenter, QString::number(currentValue, 'f', readoutPrecision));
+            valueReadout.draw(painter, QRectF(-30, 55, 60, 22));
         }
     } else {
         painter->setPen(Qt::white);
-        painter->drawText(QRectF(-30, 55, 60, 22), Qt::AlignCenter, QString::number(currentValue, 'f', readoutPrecision));
-    }
-
-    if (isPenAlarmColored == false) {
-        if (isAlarmedRed == true || isAlarmedYellow == true) {
-            emit cancelAlarm(titleText);
-            isAlarmedRed = false;
-            isAlarmedYellow = false;
-            isAcknowledged = false;
-        }
+        valueReadout.draw(painter, QRectF(-30, 55, 60, 22));
     }
 
 	//Draw marker
@@ -246,31 +189,33 @@ void BarGraph::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 
 		painter->drawPolygon(marker);
 	}
-
-
-    update();
 }
 
 void BarGraph::setTitle(QString title)
 {
 	titleText = title;
+	backgroundCache.invalidate();
 }
 
 void BarGraph::setUnit(QString unit)
 {
 	unitText = unit;
+	backgroundCache.invalidate();
 }
 
 void BarGraph::setBorders(double minimum, double maximum)
 {
 	minValue = minimum;
 	maxValue = maximum;
+	backgroundCache.invalidate();
 }
 
 void BarGraph::setPrecision(quint8 readout, quint8 bar)
 {
 	readoutPrecision = readout;
 	barPrecision = bar;
+	valueReadout.setPrecision(readoutPrecision);
+	valueReadout.setValue(currentValue);
 }
 
 void BarGraph::addBetweenValue(double value)
@@ -285,7 +230,11 @@ double BarGraph::calculateLocalValue(double value) const
 
 void BarGraph::setValue(double value)
 {
-    currentValue = value;
+    if (value != currentValue) {
+        currentValue = value;
+        valueReadout.setValue(currentValue);
+        update();
+    }
 }
 
 void BarGraph::addColorStop(ColorStop stop)
@@ -300,6 +249,11 @@ void BarGraph::changeFlashState()
     } else {
         flashState = false;
     }
+
+    //  The readout only flashes while an alarm is not acknowledged
+    if ((isAlarmedRed || isAlarmedYellow) && !isAcknowledged) {
+        update();
+    }
 }
 
 void BarGraph::setIndicatorSide(QString side)
@@ -307,9 +261,16 @@ void BarGraph::setIndicatorSide(QString side)
     indicatorSide = side;
 }
 
-void BarGraph::onAlarmAck() {
-    if (isPenAlarmColored) {
-        isAcknowledged = true;
+/*! \brief Sets the alarm state as classified by the alarm engine
+*/
+void BarGraph::setAlarmState(AlarmState state)
+{
+    if (state.level != alarmLevel || state.acknowledged != isAcknowledged) {
+        alarmLevel = state.level;
+        isAlarmedRed = alarmLevel == AlarmWarning;
+        isAlarmedYellow = alarmLevel == AlarmCaution;
+        isAcknowledged = state.acknowledged;
+        update();
     }
 }
 
@@ -23,6 +23,9 @@
 
 #include <QtWidgets>
 #include <gaugesettings.h>
+#include "alarmengine.h"
+#include "gaugecache.h"
+#include "readouttext.h"
 
 //! Bar Graph Class
 /*!
@@ -54,18 +57,21 @@ public:
     double getValue() {return currentValue;}
     QString gaugeName;
     void setIndicatorSide(QString side);
+    void setAlarmState(AlarmState state);
     void setGaugeType(QString type) {
         gaugeType = type;
         gauge.setGauge(gaugeType);
+        backgroundCache.invalidate();
     }
 
 public slots:
 	void makeVisible() {setVisible(true);};
     void makeInvisible() {setVisible(false);};
     void changeFlashState();
-    void onAlarmAck();
 private:
 	double calculateLocalValue(double value) const;
+    void paintBackground(QPainter *painter);
+    GaugeCache backgroundCache;
 	QString titleText, unitText;
 	double minValue, maxValue, currentValue;
 	QList<double> beetweenValues;
@@ -74,9 +80,9 @@ private:
     bool isAlarmedRed = false;
     bool isAlarmedYellow = false;
     bool flashState = false;
-    bool isPenAlarmColored = false;
+    AlarmLevel alarmLevel = AlarmNone;
     QPen pen;
-    QFont font;
+    ReadoutText valueReadout;
     bool horizontal=false;
     QString indicatorSide = "right";
     bool isAcknowledged = false;
@@ -95,8 +101,6 @@ protected:
 	}
 signals:
     void hasBeenClicked();
-    void sendAlarm(QString, QColor, bool);
-    void cancelAlarm(QString);
 };
 
 #endif // BARGRAPH_H
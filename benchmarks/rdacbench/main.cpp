@@ -0,0 +1,238 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <QtCore>
+#include <cstdlib>
+
+#include "rdacparser.h"
+
+// Every heap allocation made by the process is counted, the parser should not make any.
+// Qt's containers allocate with malloc()/realloc() from inside libQt5Core and operator new
+// ends up in malloc() as well, so the counting happens at the malloc level. Defining the
+// functions in the executable interposes them for every shared library; --wrap would only
+// catch the calls made from this binary's own objects.
+static quint64 allocations = 0;
+
+#ifdef __GLIBC__
+static const bool countingAllocations = true;
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *p, size_t size);
+
+void *malloc(size_t size) Q_DECL_NOTHROW
+{
+	++allocations;
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) Q_DECL_NOTHROW
+{
+	++allocations;
+	return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, size_t size) Q_DECL_NOTHROW
+{
+	++allocations;
+	return __libc_realloc(p, size);
+}
+}
+#else
+static const bool countingAllocations = false;
+#endif
+
+// Same chunk size RDACconnect::readData() reads from the serial port
+static const int serialChunk = 256;
+
+/*! \brief Builds one valid frame of the given type with a pseudo random payload
+*/
+static QByteArray buildFrame(quint8 type)
+{
+	const RDACmessageDescriptor *descriptor = rdacDescriptor(type);
+	QByteArray frame(descriptor->length, 0);
+	frame[0] = 0x05;
+	frame[1] = 0x02;
+	frame[2] = char(type);
+	quint8 sum = type;
+	for(int i = 3; i < descriptor->length - 2; ++i)
+	{
+		frame[i] = char(qrand());
+		sum += quint8(frame[i]);
+	}
+	frame[descriptor->length - 2] = char(quint8(sum + 0x55));
+	frame[descriptor->length - 1] = char(quint8(sum + 0xAA));
+	return frame;
+}
+
+/*! \brief Builds a stream of frames with all message types in the RDAC's usual ratio
+*/
+static QByteArray buildCleanStream(int frameCount)
+{
+	static const quint8 pattern[] = {1, 1, 1, 1, 2, 3, 4};
+	QByteArray stream;
+	for(int i = 0; i < frameCount; ++i)
+	{
+		stream.append(buildFrame(pattern[i % int(sizeof(pattern))]));
+	}
+	return stream;
+}
+
+struct Scenario
+{
+	QString name;
+	QByteArray stream;
+	QVector<int> chunks; // Append sizes, used cyclically
+};
+
+struct Result
+{
+	quint64 frames;
+	quint64 bytes;
+	quint64 rejected;
+	qint64 nsecs;
+	quint64 allocations;
+};
+
+/*! \brief Feeds the scenario through a parser the same way RDACconnect does
+*/
+static Result run(const Scenario &scenario, int repeat)
+{
+	RDACparser parser;
+	RDACframe frame;
+	Result result = {0, 0, 0, 0, 0};
+	int chunk = 0;
+
+	const quint64 allocationsBefore = allocations;
+	QElapsedTimer timer;
+	timer.start();
+
+	for(int r = 0; r < repeat; ++r)
+	{
+		const char *data = scenario.stream.constData();
+		int remaining = scenario.stream.size();
+		while(remaining > 0)
+		{
+			const int accepted = parser.append(data, qMin(scenario.chunks.at(chunk), remaining));
+			chunk = (chunk + 1) % scenario.chunks.size();
+			data += accepted;
+			remaining -= accepted;
+
+			RDACparser::rdacResults status;
+			while((status = parser.nextFrame(frame)) != RDACparser::rdacResultMessageIncomplete)
+			{
+				if(status == RDACparser::rdacResultMessageComplete)
+				{
+					++result.frames;
+				}
+				else
+				{
+					++result.rejected;
+				}
+			}
+		}
+	}
+
+	result.nsecs = timer.nsecsElapsed();
+	result.allocations = allocations - allocationsBefore;
+	result.bytes = quint64(scenario.stream.size()) * repeat;
+	return result;
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication a(argc, argv);
+	const int repeat = a.arguments().size() > 1 ? a.arguments().at(1).toInt() : 200;
+	qsrand(1);
+
+	QVector<Scenario> scenarios;
+
+	Scenario clean;
+	clean.name = "clean frames";
+	clean.stream = buildCleanStream(1000);
+	clean.chunks << serialChunk;
+	scenarios << clean;
+
+	// Roughly one flipped bit per thousand bytes, so a few percent of the frames are corrupted
+	Scenario bitFlips;
+	bitFlips.name = "random bit flips";
+	bitFlips.stream = buildCleanStream(1000);
+	for(int i = 0; i < bitFlips.stream.size(); ++i)
+	{
+		if(qrand() % 1000 == 0)
+		{
+			bitFlips.stream[i] = char(bitFlips.stream.at(i) ^ (1 << (qrand() % 8)));
+		}
+	}
+	bitFlips.chunks << serialChunk;
+	scenarios << bitFlips;
+
+	// Line noise between frames, seeded with false syncs so the resync path gets exercised
+	Scenario garbage;
+	garbage.name = "long garbage runs";
+	for(int i = 0; i < 100; ++i)
+	{
+		garbage.stream.append(buildCleanStream(10));
+		for(int j = 0; j < 2048; ++j)
+		{
+			garbage.stream.append(qrand() % 64 == 0 ? char(0x05) : char(qrand()));
+		}
+	}
+	garbage.chunks << serialChunk;
+	scenarios << garbage;
+
+	// Every frame type delivered in two reads, once for each possible split position
+	Scenario split;
+	split.name = "split at every byte";
+	for(int repeatFrames = 0; repeatFrames < 4; ++repeatFrames)
+	{
+		for(quint8 type = 1; type <= RDACmessageTypeCount; ++type)
+		{
+			const int length = rdacDescriptor(type)->length;
+			for(int position = 1; position < length; ++position)
+			{
+				split.stream.append(buildFrame(type));
+				split.chunks << position << length - position;
+			}
+		}
+	}
+	scenarios << split;
+
+	QTextStream out(stdout);
+	out << "RDAC parser benchmark, " << repeat << " passes per scenario\n";
+	out << qSetFieldWidth(22) << left << "scenario" << qSetFieldWidth(12) << right
+		<< "frames" << "rejected" << "frames/s" << "ns/byte" << "allocs/frame" << qSetFieldWidth(0) << "\n";
+
+	foreach(const Scenario &scenario, scenarios)
+	{
+		const Result result = run(scenario, repeat);
+		const double seconds = qMax<qint64>(result.nsecs, 1) / 1e9;
+		out << qSetFieldWidth(22) << left << scenario.name << qSetFieldWidth(12) << right
+			<< result.frames
+			<< result.rejected
+			<< QString::number(result.frames / seconds, 'f', 0)
+			<< QString::number(double(result.nsecs) / result.bytes, 'f', 2)
+			<< (countingAllocations ? QString::number(result.frames ? double(result.allocations) / result.frames : 0.0, 'f', 3) : QString("n/a"))
+			<< qSetFieldWidth(0) << "\n";
+	}
+
+	return 0;
+}
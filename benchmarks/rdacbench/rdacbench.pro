@@ -0,0 +1,39 @@
+########################################################################
+#                                                                      #
+# EngineMonitor, a graphical gauge to monitor an aircraft's engine     #
+# Copyright (C) 2017 Ryan Story                                        #
+#                                                                      #
+# This program is free software: you can redistribute it and/or modify #
+# it under the terms of the GNU General Public License as published by #
+# the Free Software Foundation, either version 3 of the License, or    #
+# (at your option) any later version.                                  #
+#                                                                      #
+# This program is distributed in the hope that it will be useful,      #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of       #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        #
+# GNU General Public License for more details.                         #
+#                                                                      #
+# You should have received a copy of the GNU General Public License    #
+# along with this program. If not, see <http://www.gnu.org/licenses/>. #
+#                                                                      #
+########################################################################
+
+# Drives the RDAC framing and decoding without a serial port or GUI
+
+QT       += core
+QT       -= gui
+
+TARGET = rdacbench
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../..
+
+SOURCES += main.cpp \
+    ../../rdacparser.cpp \
+    ../../rdaclinkstats.cpp
+
+HEADERS  += ../../rdacparser.h \
+    ../../rdacprotocol.h \
+    ../../rdaclinkstats.h
@@ -0,0 +1,301 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <QtWidgets>
+#include <algorithm>
+
+#include "enginemonitor.h"
+
+// Runs the benchmark against the same scene as the application, without a display. The
+// settings are copied into a temporary working directory first, so the log file and the
+// Hobbs time the EngineMonitor writes never touch the real ones.
+
+struct Percentiles
+{
+	qint64 p50;
+	qint64 p90;
+	qint64 p99;
+	qint64 max;
+};
+
+/*! \brief Sorts the samples and picks the percentiles, all in nanoseconds
+*/
+static Percentiles percentiles(QVector<qint64> samples)
+{
+	Percentiles result = {0, 0, 0, 0};
+	if(samples.isEmpty())
+	{
+		return result;
+	}
+	std::sort(samples.begin(), samples.end());
+	const int last = samples.size() - 1;
+	result.p50 = samples.at(last * 50 / 100);
+	result.p90 = samples.at(last * 90 / 100);
+	result.p99 = samples.at(last * 99 / 100);
+	result.max = samples.at(last);
+	return result;
+}
+
+static QString milliseconds(qint64 nsecs)
+{
+	return QString::number(nsecs / 1e6, 'f', 3);
+}
+
+/*! \brief Builds a sample that sweeps every gauge through its range, alarms included
+*/
+static EngineSample syntheticSample(int frame)
+{
+	// Roughly one sweep a minute at the display's frame rate, every channel at a different phase
+	const qreal phase = frame * 2.0 * M_PI / 1800.0;
+	EngineSample sample;
+	sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+	sample.set(ChannelRpm, 1700.0 + 1000.0 * qSin(phase));
+	sample.set(ChannelFuelFlow, 8.0 + 6.0 * qSin(phase * 1.3));
+	sample.set(ChannelOilTemp, 170.0 + 80.0 * qSin(phase * 0.7));
+	sample.set(ChannelOilPress, 55.0 + 45.0 * qSin(phase * 1.1));
+	sample.set(ChannelAmps, 10.0 + 25.0 * qSin(phase * 0.9));
+	sample.set(ChannelVolts, 13.2 + 2.0 * qSin(phase * 1.7));
+	for(int i = 0; i < 4; ++i)
+	{
+		sample.set(EngineChannel(ChannelEgt1 + i), 1350.0 + 250.0 * qSin(phase + i * 0.4));
+		sample.set(EngineChannel(ChannelCht1 + i), 330.0 + 140.0 * qSin(phase * 0.8 + i * 0.4));
+	}
+	sample.set(ChannelOat, 15.0 + 20.0 * qSin(phase * 0.3));
+	sample.set(ChannelIat, 25.0 + 20.0 * qSin(phase * 0.3));
+	sample.set(ChannelManifoldPressure, 22.0 + 6.0 * qSin(phase));
+	return sample;
+}
+
+/*! \brief Reads the samples of a flight log written by FlightLog
+*/
+static QVector<EngineSample> readLogFile(const QString &fileName)
+{
+	QVector<EngineSample> samples;
+	FlightLogReader reader;
+	if(!reader.open(fileName))
+	{
+		qWarning() << fileName << reader.errorString();
+		return samples;
+	}
+	EngineSample sample;
+	while(reader.next(&sample))
+	{
+		samples.append(sample);
+	}
+	return samples;
+}
+
+/*! \brief Copies the ini files of settingsDir into workDir/settings
+*/
+static bool copySettings(const QString &settingsDir, const QString &workDir)
+{
+	QDir source(settingsDir);
+	if(!source.exists() || !QDir(workDir).mkpath("settings"))
+	{
+		return false;
+	}
+	foreach(const QString &name, source.entryList(QStringList() << "*.ini", QDir::Files))
+	{
+		if(!QFile::copy(source.filePath(name), workDir + "/settings/" + name))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*! \brief Names an item after its class and object name, or its position if it has none
+*/
+static QString itemName(QGraphicsItem *item)
+{
+	QGraphicsObject *object = item->toGraphicsObject();
+	QString name = object ? QString(object->metaObject()->className()) : QString("QGraphicsItem");
+	if(object && !object->objectName().isEmpty())
+	{
+		return name.append(' ').append(object->objectName());
+	}
+	return name.append(QString(" (%1, %2)").arg(item->scenePos().x()).arg(item->scenePos().y()));
+}
+
+int main(int argc, char *argv[])
+{
+	// Run without a display unless a platform was chosen explicitly
+	if(qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+	{
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication a(argc, argv);
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Renders the EngineMonitor scene offscreen and reports paint times.");
+	parser.addHelpOption();
+	QCommandLineOption framesOption("frames", "Number of measured frames.", "n", "600");
+	QCommandLineOption warmupOption("warmup", "Frames rendered before measuring.", "n", "10");
+	QCommandLineOption budgetOption("budget", "Frame budget in ms, defaults to 1000 / Display/maxFps.", "ms");
+	QCommandLineOption replayOption("replay", "EngineData .emlog flight log to replay instead of synthetic samples.", "file");
+	QCommandLineOption settingsOption("settings", "Directory with settings.ini and gaugeSettings.ini.", "dir", "settings");
+	QCommandLineOption saveOption("save", "Saves the last frame as an image.", "file");
+	parser.addOption(framesOption);
+	parser.addOption(warmupOption);
+	parser.addOption(budgetOption);
+	parser.addOption(replayOption);
+	parser.addOption(settingsOption);
+	parser.addOption(saveOption);
+	parser.process(a);
+
+	const int frames = qMax(1, parser.value(framesOption).toInt());
+	const int warmup = qMax(0, parser.value(warmupOption).toInt());
+	const QString savePath = parser.isSet(saveOption) ? QFileInfo(parser.value(saveOption)).absoluteFilePath() : QString();
+
+	QVector<EngineSample> replay;
+	if(parser.isSet(replayOption))
+	{
+		replay = readLogFile(parser.value(replayOption));
+		if(replay.isEmpty())
+		{
+			qCritical() << "No samples in" << parser.value(replayOption);
+			return 2;
+		}
+	}
+
+	QTemporaryDir workDir;
+	if(!workDir.isValid() || !copySettings(parser.value(settingsOption), workDir.path()))
+	{
+		qCritical() << "Unable to copy the settings from" << parser.value(settingsOption);
+		return 2;
+	}
+	QDir::setCurrent(workDir.path());
+
+	double budget = 1000.0 / qMax(1, QSettings("settings/settings.ini", QSettings::IniFormat).value("Display/maxFps", 30).toInt());
+	if(parser.isSet(budgetOption))
+	{
+		budget = parser.value(budgetOption).toDouble();
+	}
+
+	// Same geometry and render hints as the application window. The view is never shown, the
+	// scene is rendered directly and no events are processed, so the application's own timers
+	// do not change the gauges between frames.
+	EngineMonitor engineMonitor;
+	engineMonitor.resize(800, 480);
+	QGraphicsScene *scene = engineMonitor.scene();
+	const QRectF sceneRect = scene->sceneRect();
+	QImage image(sceneRect.size().toSize(), QImage::Format_ARGB32_Premultiplied);
+
+	QList<QGraphicsItem *> items;
+	foreach(QGraphicsItem *item, scene->items(Qt::AscendingOrder))
+	{
+		if(item->isVisible())
+		{
+			items.append(item);
+		}
+	}
+
+	QVector<qint64> updateTimes, renderTimes, frameTimes;
+	QVector<QVector<qint64> > itemTimes(items.size());
+	QElapsedTimer timer;
+
+	for(int frame = 0; frame < warmup + frames; ++frame)
+	{
+		const EngineSample sample = replay.isEmpty() ? syntheticSample(frame) : replay.at(frame % replay.size());
+		const bool measured = frame >= warmup;
+
+		timer.start();
+		engineMonitor.processSample(sample);
+		engineMonitor.setValuesBulkUpdate(sample);
+		const qint64 updateTime = timer.nsecsElapsed();
+
+		QPainter painter(&image);
+		painter.setRenderHints(engineMonitor.renderHints());
+		timer.start();
+		scene->render(&painter, QRectF(image.rect()), sceneRect);
+		const qint64 renderTime = timer.nsecsElapsed();
+
+		// Second pass painting every item on its own, only to attribute the cost
+		QStyleOptionGraphicsItem option;
+		for(int i = 0; i < items.size(); ++i)
+		{
+			QGraphicsItem *item = items.at(i);
+			option.exposedRect = item->boundingRect();
+			option.rect = option.exposedRect.toAlignedRect();
+			painter.save();
+			painter.setTransform(item->sceneTransform());
+			timer.start();
+			item->paint(&painter, &option, 0);
+			const qint64 itemTime = timer.nsecsElapsed();
+			painter.restore();
+			if(measured)
+			{
+				itemTimes[i].append(itemTime);
+			}
+		}
+		painter.end();
+
+		if(measured)
+		{
+			updateTimes.append(updateTime);
+			renderTimes.append(renderTime);
+			frameTimes.append(updateTime + renderTime);
+		}
+	}
+
+	if(!savePath.isEmpty())
+	{
+		QPainter painter(&image);
+		painter.setRenderHints(engineMonitor.renderHints());
+		scene->render(&painter, QRectF(image.rect()), sceneRect);
+		painter.end();
+		image.save(savePath);
+	}
+
+	QTextStream out(stdout);
+	out << "EngineMonitor render benchmark, " << frames << " frames of " << image.width() << "x" << image.height()
+		<< " on " << QGuiApplication::platformName() << ", "
+		<< (replay.isEmpty() ? QString("synthetic samples") : QString("%1 replayed samples").arg(replay.size())) << "\n\n";
+
+	out << qSetFieldWidth(40) << left << "ms" << qSetFieldWidth(10) << right
+		<< "p50" << "p90" << "p99" << "max" << qSetFieldWidth(0) << "\n";
+	struct Row { QString name; Percentiles value; };
+	QList<Row> rows;
+	rows << Row{"sample update", percentiles(updateTimes)}
+		 << Row{"scene render", percentiles(renderTimes)}
+		 << Row{"frame", percentiles(frameTimes)};
+	for(int i = 0; i < items.size(); ++i)
+	{
+		rows << Row{QString("  ").append(itemName(items.at(i))), percentiles(itemTimes.at(i))};
+	}
+	foreach(const Row &row, rows)
+	{
+		out << qSetFieldWidth(40) << left << row.name << qSetFieldWidth(10) << right
+			<< milliseconds(row.value.p50)
+			<< milliseconds(row.value.p90)
+			<< milliseconds(row.value.p99)
+			<< milliseconds(row.value.max)
+			<< qSetFieldWidth(0) << "\n";
+	}
+
+	// Single outliers are scheduling noise on a build machine, the budget applies to the p99 frame
+	const Percentiles frame = percentiles(frameTimes);
+	const bool withinBudget = frame.p99 <= qint64(budget * 1e6);
+	out << "\nframe budget " << QString::number(budget, 'f', 3) << " ms, p99 frame " << milliseconds(frame.p99)
+		<< " ms: " << (withinBudget ? "ok" : "EXCEEDED") << "\n";
+	out.flush();
+
+	return withinBudget ? 0 : 1;
+}
@@ -19,6 +19,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "buttonbar.h"
+#include "paintprofiler.h"
 
 ButtonBar::ButtonBar(QGraphicsObject *parent) : QGraphicsObject(parent)
 {
@@ -46,6 +47,8 @@ QRectF ButtonBar::boundingRect() const
 */
 void ButtonBar::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *)
 {
+    PaintProfiler::Scope profile(this);
+
     //painter->setBrush(Qt::darkBlue);
     painter->setPen(Qt::white);
     painter->setFont(QFont("Arial", 14, QFont::Bold));
@@ -60,16 +63,20 @@ void ButtonBar::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidg
     painter->fillRect(buttonRect2, gradient2);
 
     switch(buttonDisplay) {
-    case 1: painter->drawRect(buttonRect1);
+    case 1: painter->fillRect(buttonRect3, gradient3);
+
+            painter->drawRect(buttonRect1);
             painter->drawRect(buttonRect2);
+            painter->drawRect(buttonRect3);
 
             painter->drawText(buttonRect1, Qt::AlignCenter,"Fuel");
             painter->drawText(buttonRect2, Qt::AlignCenter,"Settings");
+            painter->drawText(buttonRect3, Qt::AlignCenter,"Trends");
 
             if (isAlarmFlashing) {
-                painter->fillRect(buttonRect3, gradient3);
-                painter->drawRect(buttonRect3);
-                painter->drawText(buttonRect3, Qt::AlignCenter,"Ack");
+                painter->fillRect(buttonRect4, gradient4);
+                painter->drawRect(buttonRect4);
+                painter->drawText(buttonRect4, Qt::AlignCenter,"Ack");
             }
 
             break;
@@ -109,9 +116,21 @@ void ButtonBar::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidg
             }
 
             break;
-    }
 
-    update();
+    case 4: painter->drawRect(buttonRect1);
+            painter->drawRect(buttonRect2);
+
+            painter->drawText(buttonRect1, Qt::AlignCenter,"<-Menu");
+            painter->drawText(buttonRect2, Qt::AlignCenter, trendWholeFlight ? "2 min" : "Flight");
+
+            if (isAlarmFlashing) {
+                painter->fillRect(buttonRect4, gradient4);
+                painter->drawRect(buttonRect4);
+                painter->drawText(buttonRect4, Qt::AlignCenter,"Ack");
+            }
+
+            break;
+    }
 }
 
 void ButtonBar::mousePressEvent(QGraphicsSceneMouseEvent *event) {
@@ -125,6 +144,10 @@ void ButtonBar::mousePressEvent(QGraphicsSceneMouseEvent *event) {
             buttonDisplay = 3;
 
         } else if ((clickedPos.x() > buttonRect3.x() && clickedPos.x() < buttonRect3.x() + buttonRect3.width()) && (clickedPos.y() > buttonRect3.y())) {
+            buttonDisplay = 4;
+            emit showTrends(true);
+
+        } else if ((clickedPos.x() > buttonRect4.x() && clickedPos.x() < buttonRect4.x() + buttonRect4.width()) && (clickedPos.y() > buttonRect4.y())) {
             ackPressed();
         }
 
@@ -160,17 +183,37 @@ void ButtonBar::mousePressEvent(QGraphicsSceneMouseEvent *event) {
             ackPressed();
         }
 
+        break;
+
+    case 4: if ((clickedPos.x() > buttonRect1.x() && clickedPos.x() < buttonRect1.x() + buttonRect1.width()) && (clickedPos.y() > buttonRect1.y())) {
+            buttonDisplay = 1;
+            emit showTrends(false);
+
+        } else if ((clickedPos.x() > buttonRect2.x() && clickedPos.x() < buttonRect2.x() + buttonRect2.width()) && (clickedPos.y() > buttonRect2.y())) {
+            // switch the trend page between the last two minutes and the whole flight
+            trendWholeFlight = !trendWholeFlight;
+            emit sendTrendRange(trendWholeFlight);
+
+        } else if ((clickedPos.x() > buttonRect4.x() && clickedPos.x() < buttonRect4.x() + buttonRect4.width()) && (clickedPos.y() > buttonRect4.y())) {
+            ackPressed();
+        }
+
         break;
     }
 
+    update();
     QGraphicsItem::mousePressEvent(event);
 }
 
 void ButtonBar::ackPressed() {
     emit sendAlarmAck();
     isAlarmFlashing = false;
+    update();
 }
 
 void ButtonBar::onAlarmFlash() {
-    isAlarmFlashing = true;
+    if (!isAlarmFlashing) {
+        isAlarmFlashing = true;
+        update();
+    }
 }
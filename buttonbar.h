@@ -28,7 +28,8 @@ private:
 
     int numOfButtons = 4; /*!< Number of buttons to be drawn */
     int buttonLocation = 1; /*!< Possible Values: 1-Bottom; 2-Top; 3-Left Side; 4-Right Side */
-    int buttonDisplay = 1; /*!< Possible Values: 1-Menu; 2-Fuel; 3-Settings */
+    int buttonDisplay = 1; /*!< Possible Values: 1-Menu; 2-Fuel; 3-Settings; 4-Trends */
+    bool trendWholeFlight = false; /*!< The trend page shows the whole flight instead of two minutes */
 
     QLinearGradient gradient1 = QLinearGradient(buttonRect1.topLeft(), QPointF(0,0.7*buttonRect1.top()));
     QLinearGradient gradient2 = QLinearGradient(buttonRect2.topLeft(), QPointF(buttonRect2.left(),0.7*buttonRect2.top()));
@@ -42,6 +43,8 @@ private:
 signals:
     void sendAlarmAck();
     void sendFuelChange(QString changeDirection); //  + or -
+    void showTrends(bool visible);
+    void sendTrendRange(bool wholeFlight);
 
 public slots:
     void onAlarmFlash(); /*!< This slot is entered when a flashing alarm is created */
@@ -0,0 +1,190 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "calibration.h"
+#include <math.h>
+#include <algorithm>
+
+static const int defaultResolution = 256;
+
+CalibrationCurve::CalibrationCurve() : inputMin(0.0)
+  , inputMax(0.0)
+  , inverseStep(0.0)
+{
+}
+
+CalibrationCurve CalibrationCurve::polynomial(const QVector<qreal> &coefficients, qreal min, qreal max, const QString &unit)
+{
+	CalibrationCurve curve;
+	curve.outputUnit = unit;
+	curve.compile(TypePolynomial, coefficients, QVector<QPointF>(), min, max, defaultResolution);
+	return curve;
+}
+
+CalibrationCurve CalibrationCurve::powerLaw(qreal factor, qreal exponent, qreal min, qreal max, const QString &unit)
+{
+	CalibrationCurve curve;
+	curve.outputUnit = unit;
+	curve.compile(TypePowerLaw, QVector<qreal>() << factor << exponent, QVector<QPointF>(), min, max, defaultResolution);
+	return curve;
+}
+
+/*! \brief Replaces the curve with Calibration/<name> from the settings
+*
+* Returns false and leaves the curve unchanged if the settings do not describe a usable curve.
+*/
+bool CalibrationCurve::load(const QSettings &settings, const QString &name)
+{
+	const QString group = QString("Calibration/%1/").arg(name);
+	const QString typeName = settings.value(group + "type").toString();
+	if(typeName.isEmpty())
+	{
+		return false;
+	}
+
+	Type type;
+	if(typeName == "polynomial")
+	{
+		type = TypePolynomial;
+	}
+	else if(typeName == "power")
+	{
+		type = TypePowerLaw;
+	}
+	else if(typeName == "table")
+	{
+		type = TypeTable;
+	}
+	else
+	{
+		qWarning() << "Unknown calibration curve type" << typeName << "for" << name;
+		return false;
+	}
+
+	QVector<qreal> coefficients;
+	foreach(const QString &coefficient, settings.value(group + "coefficients").toStringList())
+	{
+		coefficients.append(coefficient.trimmed().toDouble());
+	}
+
+	QVector<QPointF> points;
+	foreach(const QString &point, settings.value(group + "points").toStringList())
+	{
+		points.append(QPointF(point.section(':', 0, 0).trimmed().toDouble(), point.section(':', 1, 1).trimmed().toDouble()));
+	}
+	std::sort(points.begin(), points.end(), [](const QPointF &a, const QPointF &b) {return a.x() < b.x();});
+
+	if((type == TypePolynomial && coefficients.isEmpty())
+			|| (type == TypePowerLaw && coefficients.size() != 2)
+			|| (type == TypeTable && points.size() < 2))
+	{
+		qWarning() << "Incomplete calibration curve" << name;
+		return false;
+	}
+	for(int i = 1; i < points.size(); ++i)
+	{
+		// Interpolating between two points at the same input would divide by zero
+		if(points.at(i).x() == points.at(i - 1).x())
+		{
+			qWarning() << "Duplicate input" << points.at(i).x() << "in calibration curve" << name;
+			return false;
+		}
+	}
+
+	const qreal min = settings.value(group + "min", type == TypeTable ? points.first().x() : 0.0).toDouble();
+	const qreal max = settings.value(group + "max", type == TypeTable ? points.last().x() : 5.0).toDouble();
+	if(!(max > min))
+	{
+		qWarning() << "Empty input range for calibration curve" << name;
+		return false;
+	}
+
+	compile(type, coefficients, points, min, max, qMax(settings.value(group + "resolution", defaultResolution).toInt(), 2));
+	outputUnit = settings.value(group + "unit").toString();
+	return true;
+}
+
+/*! \brief Applies a unit conversion to every table entry, so it costs nothing per reading
+*/
+void CalibrationCurve::convertOutput(const UnitConversion &conversion)
+{
+	for(int i = 0; i < table.size(); ++i)
+	{
+		table[i] = conversion.apply(table.at(i));
+	}
+}
+
+qreal CalibrationCurve::evaluate(Type type, const QVector<qreal> &coefficients, const QVector<QPointF> &points, qreal input)
+{
+	switch(type)
+	{
+	case TypePolynomial:
+	{
+		qreal result = 0.0;
+		for(int i = coefficients.size() - 1; i >= 0; --i)
+		{
+			result = result * input + coefficients.at(i);
+		}
+		return result;
+	}
+	case TypePowerLaw:
+		return coefficients.at(0) * pow(input, coefficients.at(1));
+	case TypeTable:
+	{
+		int i = 1;
+		while(i < points.size() - 1 && points.at(i).x() < input)
+		{
+			++i;
+		}
+		const QPointF &a = points.at(i - 1);
+		const QPointF &b = points.at(i);
+		return a.y() + (b.y() - a.y()) * (input - a.x()) / (b.x() - a.x());
+	}
+	}
+	return 0.0;
+}
+
+void CalibrationCurve::compile(Type type, const QVector<qreal> &coefficients, const QVector<QPointF> &points, qreal min, qreal max, int resolution)
+{
+	inputMin = min;
+	inputMax = max;
+	inverseStep = (resolution - 1) / (max - min);
+	table.resize(resolution);
+	for(int i = 0; i < resolution; ++i)
+	{
+		table[i] = evaluate(type, coefficients, points, min + i / inverseStep);
+	}
+}
+
+/*! \brief Converts a sender reading
+*
+* Returns false if the input is outside the range the curve is valid for.
+*/
+bool CalibrationCurve::convert(qreal input, qreal &output) const
+{
+	if(!isValid() || !(input >= inputMin && input <= inputMax))
+	{
+		return false;
+	}
+	const qreal position = (input - inputMin) * inverseStep;
+	const int index = qMin(int(position), table.size() - 2);
+	output = table.at(index) + (table.at(index + 1) - table.at(index)) * (position - index);
+	return true;
+}
@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <QtCore>
+#include "units.h"
+
+//! Calibration Curve Class
+/*!
+ * This class converts a sender reading (volts, ohms, ...) into a physical value. The curve is
+ * described as a polynomial, a power law or a piecewise-linear table and compiled into a lookup
+ * table over the valid input range, so a conversion is one table lookup and an interpolation.
+ *
+ * Curves are read from the Calibration group of the settings, e.g.
+ *
+ *   [Calibration]
+ *   rotaxOilTemp\type=power          ; output = c0 * input ^ c1
+ *   rotaxOilTemp\coefficients=497.2, -0.397
+ *   rotaxOilTemp\min=18.6
+ *   rotaxOilTemp\max=322.8
+ *   kellerOilPress\type=polynomial   ; output = c0 + c1 * input + c2 * input^2 ...
+ *   kellerOilPress\coefficients=0.75, 0.625
+ *   fuelLevel\type=table             ; input:output pairs, min and max default to the ends
+ *   fuelLevel\points=0.5:0, 1.5:7.5, 3.5:26
+ *   fuelLevel\unit=GAL
+ *
+ * An optional resolution gives the number of table entries, the default is 256. The unit is
+ * the one the curve produces, without it the base unit of the dimension is assumed. The
+ * conversion into the display unit is folded into the table with convertOutput().
+*/
+
+class CalibrationCurve
+{
+public:
+	enum Type {
+		TypePolynomial,
+		TypePowerLaw,
+		TypeTable
+	};
+	CalibrationCurve();
+	static CalibrationCurve polynomial(const QVector<qreal> &coefficients, qreal min, qreal max, const QString &unit = QString());
+	static CalibrationCurve powerLaw(qreal factor, qreal exponent, qreal min, qreal max, const QString &unit = QString());
+	bool load(const QSettings &settings, const QString &name);
+	bool isValid() const {return table.size() >= 2;}
+	bool convert(qreal input, qreal &output) const;
+	const QString &unit() const {return outputUnit;}
+	void convertOutput(const UnitConversion &conversion);
+private:
+	QString outputUnit;
+	qreal inputMin;
+	qreal inputMax;
+	qreal inverseStep;
+	QVector<qreal> table;
+	void compile(Type type, const QVector<qreal> &coefficients, const QVector<QPointF> &points, qreal min, qreal max, int resolution);
+	static qreal evaluate(Type type, const QVector<qreal> &coefficients, const QVector<QPointF> &points, qreal input);
+};
+
+#endif // CALIBRATION_H
@@ -20,6 +20,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "chtegtgauge.h"
+#include "paintprofiler.h"
 
 ChtEgt::ChtEgt(QGraphicsObject *parent) : QGraphicsObject(parent)
   , minChtValue(0.0)
@@ -32,6 +33,16 @@ ChtEgt::ChtEgt(QGraphicsObject *parent) : QGraphicsObject(parent)
     currentChtValues << 0.0 << 0.0 << 0.0 << 0.0;
     currentEgtValues << 0.0 << 0.0 << 0.0 << 0.0;
 
+    //Readouts keep their layout until their value changes
+    for (int i = 0; i < 4; i++) {
+        chtReadout[i].setFont(QFont("Arial", 18, QFont::Bold));
+        chtReadout[i].setValue(currentChtValues.at(i));
+        egtReadout[i].setFont(QFont("Arial", 18, QFont::Bold));
+        egtReadout[i].setValue(currentEgtValues.at(i));
+    }
+    chtTitle.setFont(QFont("Arial", 16));
+    chtTitle.setText("CHT");
+
     chtGauge.setGauge("CHT");
 
     minChtValue = chtGauge.getMin();
@@ -51,29 +62,19 @@ QRectF ChtEgt::boundingRect() const
     return QRectF(-240, -170, 340, 190);
 }
 
-/*! \brief Handles drawing of the object
-*
-* This member handles all of the painting logic used to draw the item and the associated style.
+/*! \brief Draws the scales, ranges and static texts, which are cached by paint()
 */
-void ChtEgt::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *)
+void ChtEgt::paintBackground(QPainter *painter)
 {
-	//Set Clipping Rect
-	painter->setClipRect(boundingRect());
-
     //Set painter for texts
     //painter->setPen(QPen(Qt::white, 1));
     painter->setFont(QFont("Arial", 16));
 
     //Draw the static texts
-    QRectF chtTitleRect = QRectF(50.0, calculateLocalChtValue(maxChtValue)-25, 50.0, 20.0);
     painter->setPen(QPen(QColor(0,255,255), 1));
     painter->drawText(QRectF(-240.0, calculateLocalChtValue(minChtValue)+7, 50.0, 20.0), Qt::AlignCenter | Qt::AlignVCenter, "EGT");
     painter->setPen(QPen(Qt::white, 1));
-    painter->drawText(QRectF(-240.0, calculateLocalChtValue(maxChtValue)-25, 50.0, 20.0), Qt::AlignCenter | Qt::AlignBottom, QString::fromUtf8("°F"));
-
-    //Set painter for texts
-    painter->setPen(QPen(Qt::white, 1));
-    painter->setFont(QFont("Arial", 18, QFont::Bold));
+    painter->drawText(QRectF(-240.0, calculateLocalChtValue(maxChtValue)-25, 50.0, 20.0), Qt::AlignCenter | Qt::AlignBottom, unitText);
 
     //Save thje painter and deactivate Antialising for rectangle drawing
     painter->save();
@@ -129,15 +130,35 @@ void ChtEgt::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget
     }
 
     painter->restore();
+}
 
-    isAlarmedRed = false;
-    isAlarmedYellow = false;
+/*! \brief Handles drawing of the object
+*
+* This member handles all of the painting logic used to draw the item and the associated style.
+*/
+void ChtEgt::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *)
+{
+	PaintProfiler::Scope profile(this);
+
+	//Set Clipping Rect
+	painter->setClipRect(boundingRect());
+
+    //Draw the static layer from the cache, it only changes with the configuration
+    if (!backgroundCache.isValid(painter)) {
+        QPainter cachePainter;
+        backgroundCache.beginUpdate(&cachePainter, painter, boundingRect());
+        paintBackground(&cachePainter);
+    }
+    backgroundCache.draw(painter);
+
+    //Set painter for texts
+    QRectF chtTitleRect = QRectF(50.0, calculateLocalChtValue(maxChtValue)-25, 50.0, 20.0);
+    painter->setPen(QPen(Qt::white, 1));
 
     //Draw the bar graphs
     for(int i=0; i < 4; i++) {
         painter->setBrush(Qt::green);
         painter->setPen(Qt::green);
-        cylinderAlarm = 1;
 
         currentLocal = calculateLocalChtValue(currentChtValues.at(i));
         QRectF barRect = QRectF(QPointF(i*60-180, -10), QPointF(i*60-140, currentLocal));
@@ -158,16 +179,6 @@ void ChtEgt::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget
                 //If value is in warning area, bar is drawn red
                 painter->setBrush(color);
                 painter->setPen(color);
-                if (color == Qt::red) {
-                    cylinderAlarm = 3;
-                    isAlarmedRed = true;
-                } else if (color == Qt::yellow) {
-                    cylinderAlarm = 2;
-
-                    if (isAlarmedRed == false) {
-                        isAlarmedYellow = true;
-                    }
-                }
             }
 
             if((currentChtValues.at(i) > minChtValue) &&
@@ -184,18 +195,12 @@ void ChtEgt::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget
             barRect = QRectF(QPointF(i*60-180, -10), QPointF(i*60-140, calculateLocalChtValue(maxChtValue)));
             painter->setPen(Qt::red);
             painter->setBrush(Qt::red);
-            cylinderAlarm = 3;
-            isAlarmedRed = true;
             painter->drawRect(barRect);
         } else if (currentChtValues.at(i) < minChtValue) {
             if (chtGauge.definitions[0].start == minChtValue) {
                 QColor tempColor = chtGauge.definitions[0].color;
                 painter->setPen(tempColor);
                 painter->setBrush(tempColor);
-                if (tempColor == Qt::yellow) {
-                    cylinderAlarm = 2;
-                    isAlarmedYellow = true;
-                }
             } else {
                 painter->setBrush(Qt::green);
             }
@@ -207,35 +212,36 @@ void ChtEgt::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget
         QRectF textRect(-40, -20, 50, 20);
         textRect.moveCenter(QPointF(i*60-160, -125));
 
-        if ((isAlarmedRed == true) && (cylinderAlarm == 3)) {
+        //The readout shows the alarm level of its cylinder
+        if (cylinderAlarm[i] == AlarmWarning) {
             if (flashState || isAcknowledged) {
                 painter->setPen(Qt::red);
                 painter->setBrush(Qt::red);
                 painter->drawRect(textRect);
                 painter->setPen(Qt::white);
-                painter->drawText(textRect, Qt::AlignCenter, QString::number(currentChtValues.at(i), 'f', 0));
+                chtReadout[i].draw(painter, textRect);
 
             } else {
                 painter->setPen(Qt::red);
-                painter->drawText(textRect, Qt::AlignCenter, QString::number(currentChtValues.at(i), 'f', 0));
+                chtReadout[i].draw(painter, textRect);
             }
 
-        } else if ((cylinderAlarm == 2)) {
+        } else if (cylinderAlarm[i] == AlarmCaution) {
             if (flashState || isAcknowledged) {
                 painter->setPen(Qt::yellow);
                 painter->setBrush(Qt::yellow);
                 painter->drawRect(textRect);
                 painter->setPen(Qt::black);
-                painter->drawText(textRect, Qt::AlignCenter, QString::number(currentChtValues.at(i), 'f', 0));
+                chtReadout[i].draw(painter, textRect);
 
             } else {
                 painter->setPen(Qt::yellow);
-                painter->drawText(textRect, Qt::AlignCenter, QString::number(currentChtValues.at(i), 'f', 0));
+                chtReadout[i].draw(painter, textRect);
             }
         } else {
             //Draw the readout
             painter->setPen(Qt::white);
-            painter->drawText(textRect, Qt::AlignCenter, QString::number(currentChtValues.at(i), 'f', 0));
+            chtReadout[i].draw(painter, textRect);
         }
 
         //Define EGT text position and move to current column
@@ -243,7 +249,7 @@ void ChtEgt::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget
         QRectF textRectEgt(-45, 65, 65, 20);
         textRectEgt.moveCenter(QPointF(i*60-160, 5));
 
-        painter->drawText(textRectEgt, Qt::AlignCenter, QString::number(currentEgtValues.at(i), 'f', 0));
+        egtReadout[i].draw(painter, textRectEgt);
 
         //  Draw the markers for the EGT gauge
         QRectF EgtRect = QRectF(QPointF(i*60-175, calculateLocalEgtValue(currentEgtValues.value(i))-3), QPointF(i*60-145, calculateLocalEgtValue(currentEgtValues.value(i))+3));
@@ -277,13 +283,11 @@ void ChtEgt::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget
             painter->setBrush(Qt::red);
             painter->drawRect(chtTitleRect);
             painter->setPen(Qt::white);
-            painter->setFont(QFont("Arial", 16));
-            painter->drawText(chtTitleRect, Qt::AlignCenter | Qt::AlignVCenter, "CHT");
+            chtTitle.draw(painter, chtTitleRect);
 
         } else {
             painter->setPen(Qt::red);
-            painter->setFont(QFont("Arial", 16));
-            painter->drawText(chtTitleRect, Qt::AlignCenter | Qt::AlignVCenter, "CHT");
+            chtTitle.draw(painter, chtTitleRect);
         }
 
     } else if ((isAlarmedYellow)) {
@@ -291,27 +295,17 @@ void ChtEgt::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget
             painter->setPen(Qt::yellow);
             painter->setBrush(Qt::yellow);
             painter->drawRect(chtTitleRect);
-            painter->setFont(QFont("Arial", 16));
             painter->setPen(Qt::black);
-            painter->drawText(chtTitleRect, Qt::AlignCenter | Qt::AlignVCenter, "CHT");
+            chtTitle.draw(painter, chtTitleRect);
 
         } else {
             painter->setPen(Qt::yellow);
-            painter->setFont(QFont("Arial", 16));
-            painter->drawText(chtTitleRect, Qt::AlignCenter | Qt::AlignVCenter, "CHT");
+            chtTitle.draw(painter, chtTitleRect);
         }
     } else {
         painter->setPen(Qt::white);
-        painter->setFont(QFont("Arial", 16));
-        painter->drawText(chtTitleRect, Qt::AlignCenter | Qt::AlignVCenter, "CHT");
-        isAcknowledged = false;
-        emit cancelAlarm("CHT");
-        isAlarmedRed = false;
-        isAlarmedYellow = false;
+        chtTitle.draw(painter, chtTitleRect);
     }
-
-    update();
-
 }
 
 double ChtEgt::calculateLocalChtValue(double value) const
@@ -329,24 +323,43 @@ void ChtEgt::addBetweenValue(double value)
 	betweenValues.append(value);
 }
 
+void ChtEgt::setUnit(QString unit)
+{
+    unitText = unit;
+    backgroundCache.invalidate();
+    update();
+}
+
 void ChtEgt::setChtValues(double val1, double val2, double val3, double val4)
 {
+    if (currentChtValues.at(0) == val1 && currentChtValues.at(1) == val2 && currentChtValues.at(2) == val3 && currentChtValues.at(3) == val4) {
+        return;
+    }
 
     currentChtValues.replace(0, val1);
     currentChtValues.replace(1, val2);
     currentChtValues.replace(2, val3);
     currentChtValues.replace(3, val4);
-
+    for (int i = 0; i < 4; i++) {
+        chtReadout[i].setValue(currentChtValues.at(i));
+    }
+    update();
 }
 
 void ChtEgt::setEgtValues(double val1, double val2, double val3, double val4)
 {
+    if (currentEgtValues.at(0) == val1 && currentEgtValues.at(1) == val2 && currentEgtValues.at(2) == val3 && currentEgtValues.at(3) == val4) {
+        return;
+    }
 
     currentEgtValues.replace(0, val1);
     currentEgtValues.replace(1, val2);
     currentEgtValues.replace(2, val3);
     currentEgtValues.replace(3, val4);
-
+    for (int i = 0; i < 4; i++) {
+        egtReadout[i].setValue(currentEgtValues.at(i));
+    }
+    update();
 }
 
 void ChtEgt::setBorders(double minimum, double maximum, double yellowBorder, double redBorder, double minEgt, double maxEgt)
@@ -357,6 +370,7 @@ void ChtEgt::setBorders(double minimum, double maximum, double yellowBorder, dou
     yellowRedChtValue = redBorder;
     minEgtValue = minEgt;
     maxEgtValue = maxEgt;
+    backgroundCache.invalidate();
 }
 
 void ChtEgt::changeFlashState()
@@ -366,8 +380,30 @@ void ChtEgt::changeFlashState()
     } else {
         flashState = false;
     }
+
+    //  The gauge only flashes while an alarm is not acknowledged
+    if ((isAlarmedRed || isAlarmedYellow) && !isAcknowledged) {
+        update();
+    }
 }
 
-void ChtEgt::onAlarmAck() {
-    isAcknowledged = true;
+/*! \brief Sets the alarm state of the CHT as classified by the alarm engine
+*/
+void ChtEgt::setAlarmState(AlarmState state)
+{
+    if ((state.level == AlarmWarning) != isAlarmedRed || (state.level == AlarmCaution) != isAlarmedYellow
+            || state.acknowledged != isAcknowledged) {
+        isAlarmedRed = state.level == AlarmWarning;
+        isAlarmedYellow = state.level == AlarmCaution;
+        isAcknowledged = state.acknowledged;
+        update();
+    }
+}
+
+void ChtEgt::setCylinderAlarmLevel(int cylinder, AlarmLevel level)
+{
+    if (cylinderAlarm[cylinder] != level) {
+        cylinderAlarm[cylinder] = level;
+        update();
+    }
 }
@@ -23,6 +23,9 @@
 
 #include <QtWidgets>
 #include <gaugesettings.h>
+#include "alarmengine.h"
+#include "gaugecache.h"
+#include "readouttext.h"
 
 //! CHT EGT Gauge Class
 /*!
@@ -43,10 +46,18 @@ public:
     const QList<double> &getCurrentChtValues() {return currentChtValues;}
     const QList<double> &getCurrentEgtValues() {return currentEgtValues;}
     void setGaugeType(QString type);
+    void setUnit(QString unit);
+    void setAlarmState(AlarmState state);
+    void setCylinderAlarmLevel(int cylinder, AlarmLevel level);
 
 private:
     double calculateLocalChtValue(double value) const;
     double calculateLocalEgtValue(double value) const;
+    void paintBackground(QPainter *painter);
+    GaugeCache backgroundCache;
+    ReadoutText chtReadout[4];
+    ReadoutText egtReadout[4];
+    ReadoutText chtTitle;
     double minChtValue, maxChtValue;
     double greenYellowChtValue, yellowRedChtValue;
     QList<double> currentChtValues;
@@ -57,10 +68,11 @@ private:
     bool isAlarmedRed = false;
     bool isAlarmedYellow = false;
     bool flashState = false;
-    int cylinderAlarm;
+    AlarmLevel cylinderAlarm[4] = {AlarmNone, AlarmNone, AlarmNone, AlarmNone};
     bool isAcknowledged = false;
 
     QString chtGaugeType;
+    QString unitText;
     GaugeSettings chtGauge;
     int numOfRanges;
     double startRange;
@@ -73,13 +85,8 @@ private:
     double currentLocal;
 
     GaugeSettings egtGauge;
-signals:
-    void sendAlarm(QString, QColor, bool);
-    void cancelAlarm(QString);
-
 public slots:
     void changeFlashState();
-    void onAlarmAck();
 };
 
 #endif // CHTEGTGAUGE_H
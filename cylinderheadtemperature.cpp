@@ -164,7 +164,6 @@ void CylinderHeadTemperature::paint(QPainter *painter, const QStyleOptionGraphic
             //Draw the readout
             painter->drawText(textRect, Qt::AlignCenter, QString::number(currentValues.at(i), 'f', 0));
         }
-        update();
 	}
 
 }
@@ -225,8 +224,7 @@ void CylinderHeadTemperature::setValues(double val1, double val2, double val3, d
 
         isAlarmedYellow = false;
     }
-
-
+	update();
 }
 
 void CylinderHeadTemperature::setBorders(double minimum, double maximum, double yellowBorder, double redBorder)
@@ -244,4 +242,9 @@ void CylinderHeadTemperature::changeFlashState()
     } else {
         flashState = false;
     }
+
+    //  Only an alarmed readout looks different in the new phase
+    if (isAlarmedRed || isAlarmedYellow) {
+        update();
+    }
 }
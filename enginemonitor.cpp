@@ -26,6 +26,8 @@ EngineMonitor::EngineMonitor(QWidget *parent) : QGraphicsView(parent)
   , graphicsScene(this)
   , settings("settings/settings.ini", QSettings::IniFormat, parent)
   , gaugeSettings("settings/gaugeSettings.ini", QSettings::IniFormat, parent)
+  , paintProfiler(0)
+  , trendWholeFlight(false)
 {
 
 	//Initializing the window behaviour and it's scene
@@ -34,6 +36,9 @@ EngineMonitor::EngineMonitor(QWidget *parent) : QGraphicsView(parent)
 	setScene(&graphicsScene);
     setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
 
+    // Gauges only repaint when something they show changed, at most Display/maxFps times a second
+    frameScheduler = new FrameScheduler(this, this);
+
 	//Setting up the items to be displayed
     setupRpmIndicator();
     setupBarGraphs();
@@ -45,6 +50,7 @@ EngineMonitor::EngineMonitor(QWidget *parent) : QGraphicsView(parent)
     setupStatusItem();
     setupWindVector();
     setupHourMeter();
+    setupAlarmEngine();
 
     this->mapToScene(this->rect());
     this->setFrameShape(QGraphicsView::NoFrame);
@@ -52,6 +58,7 @@ EngineMonitor::EngineMonitor(QWidget *parent) : QGraphicsView(parent)
     graphicsScene.setSceneRect(0,0,800,480);
     buttonBar.setPos(0,graphicsScene.height());
     graphicsScene.addItem(&buttonBar);
+    setupPaintProfiler();
     graphicsScene.update();
 
     //  Get the interface type, Arduino or RDAC
@@ -64,12 +71,14 @@ EngineMonitor::EngineMonitor(QWidget *parent) : QGraphicsView(parent)
     customPlot = new QCustomPlot();
     customPlot->setStyleSheet("border: 8px solid red;background-color: yellow");
 
-    QGraphicsProxyWidget *test;
-    test = new QGraphicsProxyWidget();
-    test->setWidget(customPlot);
-    test->setPos(0, 200);
-
-    //graphicsScene.addItem(test);
+    // The trend page is shown above the gauges from the button bar
+    trendPage = new QGraphicsProxyWidget();
+    trendPage->setWidget(customPlot);
+    trendPage->setPos(0, 200);
+    trendPage->setZValue(10.0);
+    trendPage->setVisible(false);
+    trendPage->setObjectName("trendPage");
+    graphicsScene.addItem(trendPage);
 
     customPlot->setFixedHeight(150);
     customPlot->setFixedWidth(300);
@@ -99,10 +108,16 @@ EngineMonitor::EngineMonitor(QWidget *parent) : QGraphicsView(parent)
     customPlot->xAxis->setTicks(false);
     customPlot->xAxis->grid()->setVisible(false);
 
+    // The CHT trend keeps one min/max bucket per pixel column of the two minute window
+    for (int i = 0; i < 4; i++) {
+        chtTrend[i].setResolution(customPlot->width() + 1, 120.0 / customPlot->width());
+    }
+    trendClock.start();
 
-    // setup a timer that repeatedly calls MainWindow::realtimeDataSlot:
-    connect(&dataTimer, SIGNAL(timeout()), this, SLOT(realtimeDataSlot()));
-    dataTimer.start(1000); // Interval 0 means to refresh as fast as possible
+    // While the page is shown, arriving samples replot it at most every half second
+    trendReplotTimer.setSingleShot(true);
+    trendReplotTimer.setInterval(500);
+    connect(&trendReplotTimer, SIGNAL(timeout()), this, SLOT(realtimeDataSlot()));
 
     // End plot stuff
 
@@ -140,65 +155,67 @@ EngineMonitor::EngineMonitor(QWidget *parent) : QGraphicsView(parent)
 
 EngineMonitor::~EngineMonitor()
 {
-	logFile->close();
+	flightLog.close();
+    if (paintProfiler) {
+        paintProfiler->writeReport(QString("PaintProfile ").append(QDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh.mm.ss")).append(".txt"));
+    }
 }
 
-void EngineMonitor::setupLogFile()
+/*! \brief Paints a frame, timed as a whole when the paint profiler is enabled
+*/
+void EngineMonitor::paintEvent(QPaintEvent *event)
 {
-    logFile = new QFile(QString("EngineData ").append(QDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh.mm.ss")).append(".csv"), this);
-	if(logFile->open(QIODevice::WriteOnly))
-	{
-		QTimer *writeLogFileTimer = new QTimer(this);
-		connect(writeLogFileTimer, SIGNAL(timeout()), this, SLOT(writeLogFile()));
-		writeLogFileTimer->setSingleShot(false);
-		writeLogFileTimer->start(settings.value("Logging/SampleRate", 1).toInt() * 1000);
-	}
-	else
-	{
-		userMessageHandler("Unable to open log file", "Unable to open log file, closing application.", true);
-	}
+    if (paintProfiler) {
+        paintProfiler->beginFrame();
+        QGraphicsView::paintEvent(event);
+        paintProfiler->endFrame();
+    } else {
+        QGraphicsView::paintEvent(event);
+    }
+}
 
-	logFile->write("[Header]\r\n");
-	logFile->write("Created with Cardinal EMS - Build BETA\r\n");
-	logFile->write(QString("Call Sign: %1\r\n").arg(settings.value("Aircraft/CALL_SIGN").toString()).toLatin1());
-	logFile->write(QString("Aircraft Model: %1\r\n").arg(settings.value("Aircraft/AIRCRAFT_MODEL").toString()).toLatin1());
-	logFile->write(QString("Aircraft S/N: %1\r\n").arg(settings.value("Aircraft/AIRCRAFT_SN").toString()).toLatin1());
-	logFile->write(QString("Engine Type: %1\r\n").arg(settings.value("Aircraft/ENGINE_TYPE").toString()).toLatin1());
-	logFile->write(QString("Engine S/N: %1\r\n").arg(settings.value("Aircraft/ENGINE_SN").toString()).toLatin1());
-    logFile->write(QString("All temperatures in degree %1\r\n oil pressure in %2\r\n fuel flow in %3.\r\n").arg(settings.value("Units/temp/", "F").toString(),settings.value("Units/pressure","psi").toString(),settings.value("Units/fuelFlow","gph").toString()).toLatin1());
-	logFile->write("[data]\r\n");
-    logFile->write("INDEX;TIME;EGT1;EGT2;EGT3;EGT4;CHT1;CHT2;CHT3;CHT4;OILT;OILP;OAT;IAT;BAT;CUR;RPM;MAP;FF;HOBBS;FLIGHT;MARK\r\n");
+/*! \brief Names the gauges and adds the paint time overlay if Display/paintProfiler is set
+*/
+void EngineMonitor::setupPaintProfiler()
+{
+    // The names identify the gauges in the profile and in the render benchmark
+    rpmIndicator.setObjectName("rpm");
+    oilTemperature.setObjectName("oilTemperature");
+    oilPressure.setObjectName("oilPressure");
+    voltMeter.setObjectName("volts");
+    ampereMeter.setObjectName("amps");
+    fuelFlow.setObjectName("fuelFlow");
+    insideAirTemperature.setObjectName("iat");
+    outsideAirTemperature.setObjectName("oat");
+    chtEgt.setObjectName("chtEgt");
+    fuelDisplay.setObjectName("fuelDisplay");
+    fuelManagement.setObjectName("fuelManagement");
+    alarmWindow.setObjectName("alarmWindow");
+    windVector.setObjectName("windVector");
+    hobbs.setObjectName("hobbs");
+    buttonBar.setObjectName("buttonBar");
+
+    if (!settings.value("Display/paintProfiler", false).toBool()) {
+        return;
+    }
+    paintProfiler = new PaintProfiler();
+    paintProfiler->setFrameBudget(1000.0 / frameScheduler->maximumFps());
+    paintProfiler->setPos(0, 0);
+    graphicsScene.addItem(paintProfiler);
 }
 
-void EngineMonitor::writeLogFile()
+/*! \brief Opens the binary flight log, every sample is logged unless Logging/SampleRate limits it
+*
+* Logging/SampleRate is the minimum time between logged samples in seconds, 0 logs every sample.
+* Use the flightlogexport tool to convert a log to CSV.
+*/
+void EngineMonitor::setupLogFile()
 {
-	static quint64 sample = 0;
-	logFile->write(QString::number(sample).append(';').toLatin1());
-	logFile->write(QDateTime::currentDateTimeUtc().toString("yyyy-dd-MM hh:mm:ss").append(';').toLatin1());
-    QList<double> egtValues = chtEgt.getCurrentEgtValues();
-	logFile->write(QString::number(egtValues.value(0, 0.0), 'f', 0).append(';').toLatin1());
-	logFile->write(QString::number(egtValues.value(1, 0.0), 'f', 0).append(';').toLatin1());
-	logFile->write(QString::number(egtValues.value(2, 0.0), 'f', 0).append(';').toLatin1());
-	logFile->write(QString::number(egtValues.value(3, 0.0), 'f', 0).append(';').toLatin1());
-    QList<double> chtValues = chtEgt.getCurrentChtValues();
-	logFile->write(QString::number(chtValues.value(0, 0.0), 'f', 0).append(';').toLatin1());
-	logFile->write(QString::number(chtValues.value(1, 0.0), 'f', 0).append(';').toLatin1());
-	logFile->write(QString::number(chtValues.value(2, 0.0), 'f', 0).append(';').toLatin1());
-	logFile->write(QString::number(chtValues.value(3, 0.0), 'f', 0).append(';').toLatin1());
-	logFile->write(QString::number(oilTemperature.getValue(), 'f', 0).append(';').toLatin1());
-	logFile->write(QString::number(oilPressure.getValue(), 'f', 1).append(';').toLatin1());
-	logFile->write(QString::number(outsideAirTemperature.getValue(), 'f', 1).append(';').toLatin1());
-	logFile->write(QString::number(insideAirTemperature.getValue(), 'f', 1).append(';').toLatin1());
-	logFile->write(QString::number(voltMeter.getValue(), 'f', 1).append(';').toLatin1());
-	logFile->write(QString::number(ampereMeter.getValue(), 'f', 1).append(';').toLatin1());
-	logFile->write(QString::number(rpmIndicator.getValue(), 'f', 0).append(';').toLatin1());
-	logFile->write(QString::number(manifoldPressure.getValue(), 'f', 1).append(';').toLatin1());
-    logFile->write(QString::number(fuelFlow.getValue(), 'f', 1).append(';').toLatin1());
-    logFile->write(QString(hobbs.getHobbsTime().append(';')).toLatin1());
-    logFile->write(QString(hobbs.getFlightTime().append(';')).toLatin1());
-    logFile->write("\r\n");
-	logFile->flush();
-	++sample;
+    const QString fileName = QString("EngineData ").append(QDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh.mm.ss")).append(".emlog");
+    flightLog.setSampleInterval(qRound64(settings.value("Logging/SampleRate", 1).toDouble() * 1000.0));
+    if (!flightLog.open(fileName, settings)) {
+		userMessageHandler("Unable to open log file", "Unable to open log file, closing application.", true);
+	}
 }
 
 void EngineMonitor::setupAlarm()
@@ -260,6 +277,7 @@ void EngineMonitor::setupRpmIndicator()
 void EngineMonitor::setupChtEgt()
 {
     chtEgt.setPos(700, 450);
+    chtEgt.setUnit(unitLabel(temperatureUnitFromString(settings.value("Units/temp", "F").toString())));
     graphicsScene.addItem(&chtEgt);
 }
 
@@ -267,7 +285,7 @@ void EngineMonitor::setupBarGraphs()
 {
     oilTemperature.setPos(620, 60);
     oilTemperature.setTitle("OIL T");
-    oilTemperature.setUnit(settings.value("Units/temp").toString().toLatin1());
+    oilTemperature.setUnit(unitLabel(temperatureUnitFromString(settings.value("Units/temp", "F").toString())));
     oilTemperature.setBorders(gaugeSettings.value("OilTemp/min",0).toInt(),gaugeSettings.value("OilTemp/max",0).toInt());
     oilTemperature.setIndicatorSide("left");
     oilTemperature.setGaugeType("OilTemp");
@@ -308,7 +326,7 @@ void EngineMonitor::setupBarGraphs()
 
     insideAirTemperature.setPos(800, 200);
     insideAirTemperature.setTitle("IAT");
-    insideAirTemperature.setUnit(settings.value("Units/temp").toString().toLatin1());
+    insideAirTemperature.setUnit(unitLabel(temperatureUnitFromString(settings.value("Units/temp", "F").toString())));
     insideAirTemperature.setBorders(-10.0, 40);
     insideAirTemperature.setPrecision(1);
     graphicsScene.addItem(&insideAirTemperature);
@@ -318,7 +336,7 @@ void EngineMonitor::setupBarGraphs()
 
     outsideAirTemperature.setPos(850, 350);
     outsideAirTemperature.setTitle("OAT");
-    outsideAirTemperature.setUnit(settings.value("Units/temp").toString().toLatin1());
+    outsideAirTemperature.setUnit(unitLabel(temperatureUnitFromString(settings.value("Units/temp", "F").toString())));
     outsideAirTemperature.setPrecision(1);
     graphicsScene.addItem(&outsideAirTemperature);
     connect(&insideAirTemperature, SIGNAL(hasBeenClicked()), &insideAirTemperature, SLOT(makeInvisible()));
@@ -457,11 +475,7 @@ void EngineMonitor::demoFunction()
         oilTemp = 100.0;
 	}
 	oilTemp -= 0.1;
-    if (oilTemp < warmupTemp) {
-        rpmIndicator.isWarmup = true;
-    } else {
-        rpmIndicator.isWarmup = false;
-    }
+    rpmIndicator.setWarmup(oilTemp < warmupTemp);
 	oilTemperature.setValue(oilTemp);
 
 	static double oilPress = 0.0;
@@ -509,6 +523,19 @@ void EngineMonitor::demoFunction()
 	outsideAirTemperature.setValue(airTemp);
 	insideAirTemperature.setValue(airTemp);
 
+	//Run the demo values through the alarm engine like a received sample
+	EngineSample demoSample;
+	demoSample.set(ChannelRpm, rpm);
+	demoSample.set(ChannelOilTemp, oilTemp);
+	demoSample.set(ChannelOilPress, oilPress);
+	demoSample.set(ChannelVolts, volts);
+	demoSample.set(ChannelAmps, amperes);
+	demoSample.set(ChannelFuelFlow, flow);
+	for(int i = 0; i < 4; i++)
+	{
+		demoSample.set(EngineChannel(ChannelCht1 + i), chtEgt.getCurrentChtValues().at(i));
+	}
+	processSample(demoSample);
 }
 
 //void EngineMonitor::saveSceneToSvg(const QString fileName)
@@ -525,54 +552,136 @@ void EngineMonitor::demoFunction()
 ////	painter.end();
 //}
 
-void EngineMonitor::setValuesBulkUpdate(qreal rpm, qreal fuelFlowValue, qreal oilTemp, qreal oilPress, qreal amps, qreal volts, qreal egt1, qreal egt2, qreal egt3, qreal egt4, qreal cht1, qreal cht2, qreal cht3, qreal cht4, qreal oat, qreal iat) {
-    rpmIndicator.setValue(rpm);
-    fuelDisplay.setFuelFlow(fuelFlowValue);
-    fuelFlow.setValue(fuelFlowValue);
-    oilTemperature.setValue(oilTemp);
-    oilPressure.setValue(oilPress);
-    ampereMeter.setValue(amps);
-    voltMeter.setValue(volts);
-    chtEgt.setEgtValues(egt1, egt2, egt3, egt4);
-    chtEgt.setChtValues(cht1, cht2, cht3, cht4);
-    outsideAirTemperature.setValue(oat);
-    insideAirTemperature.setValue(iat);
-
-    if (oilTemp < warmupTemp ) {
-        rpmIndicator.isWarmup = true;
+/*! \brief Runs every received sample through the alarm engine, the trends and the flight log
+*
+* Called for each sample as it is converted, independent of how often the gauges are updated.
+*/
+void EngineMonitor::processSample(const EngineSample &sample) {
+    if (sample.isValid(ChannelOilTemp)) {
+        alarmEngine.setWarmup(sample.value[ChannelOilTemp] < warmupTemp);
+    }
+    alarmEngine.processSample(sample);
+    addTrendSample(sample);
+    flightLog.addSample(sample, hobbs.getHobbsSeconds(), hobbs.getFlightSeconds());
+}
+
+/*! \brief Shows all valid channels of the sample, the gauges of the other channels keep their values
+*/
+void EngineMonitor::setValuesBulkUpdate(const EngineSample &sample) {
+    const qreal *value = sample.value;
+
+    if (sample.isValid(ChannelRpm)) {
+        rpmIndicator.setValue(value[ChannelRpm]);
+        if (value[ChannelRpm] > 0) {
+            hobbs.setEngineOn(true);
+        }
+    }
+    if (sample.isValid(ChannelFuelFlow)) {
+        fuelDisplay.setFuelFlow(value[ChannelFuelFlow]);
+        fuelFlow.setValue(value[ChannelFuelFlow]);
+    }
+    if (sample.isValid(ChannelOilTemp)) {
+        oilTemperature.setValue(value[ChannelOilTemp]);
+        rpmIndicator.setWarmup(value[ChannelOilTemp] < warmupTemp);
+    }
+    if (sample.isValid(ChannelOilPress)) {
+        oilPressure.setValue(value[ChannelOilPress]);
+    }
+    if (sample.isValid(ChannelAmps)) {
+        ampereMeter.setValue(value[ChannelAmps]);
+    }
+    if (sample.isValid(ChannelVolts)) {
+        voltMeter.setValue(value[ChannelVolts]);
+    }
+    if (sample.isValid(ChannelEgt1)) {
+        chtEgt.setEgtValues(value[ChannelEgt1], value[ChannelEgt2], value[ChannelEgt3], value[ChannelEgt4]);
+    }
+    if (sample.isValid(ChannelCht1)) {
+        chtEgt.setChtValues(value[ChannelCht1], value[ChannelCht2], value[ChannelCht3], value[ChannelCht4]);
+    }
+    if (sample.isValid(ChannelOat)) {
+        outsideAirTemperature.setValue(value[ChannelOat]);
+    }
+    if (sample.isValid(ChannelIat)) {
+        insideAirTemperature.setValue(value[ChannelIat]);
+    }
+    if (sample.isValid(ChannelManifoldPressure)) {
+        manifoldPressure.setValue(value[ChannelManifoldPressure]);
+    }
+}
+
+/*! \brief Adds the sample to the flight's history and its CHTs to the two minute trend
+*
+* Every sample counts towards the min/max envelope of its buckets.
+*/
+void EngineMonitor::addTrendSample(const EngineSample &sample)
+{
+    const qreal key = trendClock.elapsed() / 1000.0;
+    trendHistory.add(key, sample);
+    for (int i = 0; i < 4; i++) {
+        if (sample.isValid(EngineChannel(ChannelCht1 + i))) {
+            chtTrend[i].add(key, sample.value[ChannelCht1 + i]);
+        }
+    }
+
+    // A hidden page only collects, it is replotted when it is shown again
+    if (trendPage->isVisible() && !trendReplotTimer.isActive()) {
+        trendReplotTimer.start();
+    }
+}
+
+/*! \brief Shows or hides the trend page, it is brought up to date before it is shown
+*/
+void EngineMonitor::showTrendPage(bool visible)
+{
+    if (visible) {
+        realtimeDataSlot();
     } else {
-        rpmIndicator.isWarmup = false;
+        trendReplotTimer.stop();
     }
+    trendPage->setVisible(visible);
+}
 
-    if (rpm > 0) {
-        hobbs.setEngineOn(true);
+/*! \brief Switches the trend plot between the last two minutes and the whole flight
+*/
+void EngineMonitor::setTrendWholeFlight(bool wholeFlight)
+{
+    trendWholeFlight = wholeFlight;
+    if (trendPage->isVisible()) {
+        realtimeDataSlot();
     }
 }
 
+/*! \brief Replaces the plot's data with the envelope of the trend buffers and scrolls it
+*
+* Each bucket becomes a vertical stroke from its minimum to its maximum. The two minute view
+* uses the per-column CHT buffers, the whole flight the coarsest pyramid level needed to fit
+* the plot's width. Either way the plot never holds more than two points per pixel column and
+* replot() costs the same at any flight time.
+*/
 void EngineMonitor::realtimeDataSlot()
 {
-  static QTime time(QTime::currentTime());
-  // calculate two new data points:
-  double key = time.elapsed()/1000.0; // time elapsed since start of demo, in seconds
-  static double lastPointKey = 0;
-  if (key-lastPointKey > 0.500 /*.002*/) // at most add point every 2 ms
-  {
-    // add data to lines:
-    customPlot->graph(0)->addData(key, chtEgt.getCurrentChtValues().at(0));
-    customPlot->graph(1)->addData(key, chtEgt.getCurrentChtValues().at(1));
-    customPlot->graph(2)->addData(key, chtEgt.getCurrentChtValues().at(2));
-    customPlot->graph(3)->addData(key, chtEgt.getCurrentChtValues().at(3));
-    //customPlot->graph(1)->addData(key, qCos(key)+qrand()/(double)RAND_MAX*0.5*qSin(key/0.4364));
-    // rescale value (vertical) axis to fit the current data:
-//    customPlot->graph(0)->rescaleValueAxis();
-//    customPlot->graph(1)->rescaleValueAxis(true);
-    lastPointKey = key;
-
-    // make key axis range scroll with the data (at a constant range size of 8):
-    customPlot->xAxis->setRange(key, 120, Qt::AlignRight);
-    customPlot->replot();
-  }
+    const qreal now = trendClock.elapsed() / 1000.0;
+    const int historyLevel = trendHistory.levelFor(now, customPlot->width());
+
+    QVector<QCPGraphData> envelope;
+    for (int i = 0; i < 4; i++) {
+        const TrendBuffer &trend = trendWholeFlight ? trendHistory.level(EngineChannel(ChannelCht1 + i), historyLevel) : chtTrend[i];
+        envelope.resize(0);
+        envelope.reserve(2 * trend.size());
+        for (int j = 0; j < trend.size(); j++) {
+            const TrendBucket &bucket = trend.at(j);
+            envelope.append(QCPGraphData(bucket.start, bucket.minimum));
+            if (bucket.maximum != bucket.minimum) {
+                envelope.append(QCPGraphData(bucket.start, bucket.maximum));
+            }
+        }
+        customPlot->graph(i)->data()->set(envelope, true);
+    }
 
+    // Scroll the key axis with the data, two minutes or everything since start
+    customPlot->xAxis->setRange(now, trendWholeFlight ? qMax(now, 120.0) : 120.0, Qt::AlignRight);
+    customPlot->replot();
 }
 
 void EngineMonitor::processPendingDatagrams() {
@@ -618,30 +727,16 @@ void EngineMonitor::connectSignals() {
     connect(&flashTimer, SIGNAL(timeout()), &ampereMeter, SLOT(changeFlashState()));
 
     qDebug()<<"Connecting RPM signals";
-    //  Connect signal for alarm from rpm indicator
-    connect(&rpmIndicator, SIGNAL(sendAlarm(QString,QColor,bool)), &alarmWindow, SLOT(onAlarm(QString,QColor,bool)));
-    connect(&rpmIndicator, SIGNAL(cancelAlarm(QString)), &alarmWindow, SLOT(onRemoveAlarm(QString)));
 
     qDebug()<<"Connecting CHT/EGT Signals";
-    //  Connect signal for alarm from CHT/EGT
-    connect(&chtEgt, SIGNAL(sendAlarm(QString,QColor,bool)), &alarmWindow, SLOT(onAlarm(QString,QColor,bool)));
-    connect(&chtEgt, SIGNAL(cancelAlarm(QString)), &alarmWindow, SLOT(onRemoveAlarm(QString)));
 
-    //  Connect signal for alarm from Volt Meter
-    connect(&voltMeter, SIGNAL(sendAlarm(QString,QColor,bool)), &alarmWindow, SLOT(onAlarm(QString,QColor,bool)));
-    connect(&voltMeter, SIGNAL(cancelAlarm(QString)), &alarmWindow, SLOT(onRemoveAlarm(QString)));
 
-    //  Connect signal for alarm from OILT
-    connect(&oilTemperature, SIGNAL(sendAlarm(QString,QColor,bool)), &alarmWindow, SLOT(onAlarm(QString,QColor,bool)));
-    connect(&oilTemperature, SIGNAL(cancelAlarm(QString)), &alarmWindow, SLOT(onRemoveAlarm(QString)));
 
-    //  Connect signal for alarm from OILP
-    connect(&oilPressure, SIGNAL(sendAlarm(QString,QColor,bool)), &alarmWindow, SLOT(onAlarm(QString,QColor,bool)));
-    connect(&oilPressure, SIGNAL(cancelAlarm(QString)), &alarmWindow, SLOT(onRemoveAlarm(QString)));
 
-    //  Connect signal for alarm from ampere meter
-    connect(&ampereMeter, SIGNAL(sendAlarm(QString,QColor,bool)), &alarmWindow, SLOT(onAlarm(QString,QColor,bool)));
-    connect(&ampereMeter, SIGNAL(cancelAlarm(QString)), &alarmWindow, SLOT(onRemoveAlarm(QString)));
+    //  Connect the alarm engine to the alarm window and the gauges
+    connect(&alarmEngine, SIGNAL(sendAlarm(QString,QColor,bool)), &alarmWindow, SLOT(onAlarm(QString,QColor,bool)));
+    connect(&alarmEngine, SIGNAL(cancelAlarm(QString)), &alarmWindow, SLOT(onRemoveAlarm(QString)));
+    connect(&alarmEngine, SIGNAL(alarmStateChanged(int)), this, SLOT(onAlarmStateChanged(int)));
 
     // Connect buttonBar to the alarm window for alarm acknowledgement
     connect(&buttonBar, SIGNAL(sendAlarmAck()), &alarmWindow, SLOT(onAlarmAck()));
@@ -649,22 +744,52 @@ void EngineMonitor::connectSignals() {
     // Connect buttonBar to the fuelDisplay window to increment fuel amount
     connect(&buttonBar, SIGNAL(sendFuelChange(QString)), &fuelDisplay, SLOT(onFuelAmountChange(QString)));
 
+    // Connect buttonBar to the trend page
+    connect(&buttonBar, SIGNAL(showTrends(bool)), this, SLOT(showTrendPage(bool)));
+    connect(&buttonBar, SIGNAL(sendTrendRange(bool)), this, SLOT(setTrendWholeFlight(bool)));
+
     // Connect signal for a flashing alarm to the button bar to be able to show the 'Ack' button
     connect(&alarmWindow, SIGNAL(flashingAlarm()), &buttonBar, SLOT(onAlarmFlash()));
 
     // Connect signal to stop flashing alarm after it has been acknowledged
-    connect(&alarmWindow, SIGNAL(stopAlarmFlash()), &chtEgt, SLOT(onAlarmAck()));
-    connect(&alarmWindow, SIGNAL(stopAlarmFlash()), &voltMeter, SLOT(onAlarmAck()));
-    connect(&alarmWindow, SIGNAL(stopAlarmFlash()), &oilTemperature, SLOT(onAlarmAck()));
-    connect(&alarmWindow, SIGNAL(stopAlarmFlash()), &oilPressure, SLOT(onAlarmAck()));
-    connect(&alarmWindow, SIGNAL(stopAlarmFlash()), &ampereMeter, SLOT(onAlarmAck()));
-    connect(&alarmWindow, SIGNAL(stopAlarmFlash()), &rpmIndicator, SLOT(onAlarmAck()));
+    connect(&alarmWindow, SIGNAL(stopAlarmFlash()), &alarmEngine, SLOT(acknowledge()));
 
     qDebug()<<"Connecting hobb/flight time Signals";
     // Connect a timer for handling hobbs/flight time
     connect(&clockTimer, SIGNAL(timeout()), &hobbs, SLOT(onTic()));
 }
 
+/*! \brief Creates an alarm source for every gauge with alarm ranges
+*
+* RPM and fuel flow are classified for their gauges only and not shown in the alarm window.
+*/
+void EngineMonitor::setupAlarmEngine() {
+    // Like the RPM gauge always did, anything beyond the scale is an overspeed (or underspeed) warning
+    rpmAlarm = alarmEngine.addSource("RPM", "RPM", ChannelRpm, 1, false, true);
+    chtAlarm = alarmEngine.addSource("CHT", "CHT", ChannelCht1, 4);
+    barGraphAlarms.insert(alarmEngine.addSource("OIL T", "OilTemp", ChannelOilTemp), &oilTemperature);
+    barGraphAlarms.insert(alarmEngine.addSource("OIL P", "OilPress", ChannelOilPress), &oilPressure);
+    barGraphAlarms.insert(alarmEngine.addSource("VOLTS", "Volt", ChannelVolts), &voltMeter);
+    barGraphAlarms.insert(alarmEngine.addSource("AMPS", "Amp", ChannelAmps), &ampereMeter);
+    barGraphAlarms.insert(alarmEngine.addSource("FF", "Fuel", ChannelFuelFlow, 1, false), &fuelFlow);
+}
+
+/*! \brief Hands a changed alarm state to the gauge showing it
+*/
+void EngineMonitor::onAlarmStateChanged(int source) {
+    const AlarmState state = alarmEngine.sourceState(source);
+    if (source == rpmAlarm) {
+        rpmIndicator.setAlarmState(state);
+    } else if (source == chtAlarm) {
+        chtEgt.setAlarmState(state);
+        for (int i = 0; i < 4; i++) {
+            chtEgt.setCylinderAlarmLevel(i, alarmEngine.channelLevel(EngineChannel(ChannelCht1 + i)));
+        }
+    } else if (barGraphAlarms.contains(source)) {
+        barGraphAlarms.value(source)->setAlarmState(state);
+    }
+}
+
 void EngineMonitor::setupHourMeter() {
     hobbs.setPos(250, 360);
     graphicsScene.addItem(&hobbs);
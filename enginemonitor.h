@@ -36,6 +36,14 @@
 #include <udpsocket.h>
 #include <windvector.h>
 #include <hourmeter.h>
+#include "enginesample.h"
+#include "units.h"
+#include "framescheduler.h"
+#include "alarmengine.h"
+#include "paintprofiler.h"
+#include "trendbuffer.h"
+#include "trendpyramid.h"
+#include "flightlog.h"
 
 //! Engine Monitor Class
 /*!
@@ -48,6 +56,8 @@ class EngineMonitor : public QGraphicsView
 public:
 	EngineMonitor(QWidget *parent = 0);
 	~EngineMonitor();
+protected:
+    void paintEvent(QPaintEvent *event);
 private:
     void setupAlarm();
 	void setupRpmIndicator();
@@ -66,6 +76,9 @@ private:
     void cancelAlarm(QString alarmGauge);
     void connectSignals();
     void setupHourMeter();
+    void setupAlarmEngine();
+    void setupPaintProfiler();
+    void addTrendSample(const EngineSample &sample);
 
 	QGraphicsScene graphicsScene;
     RpmIndicator rpmIndicator;
@@ -81,18 +94,29 @@ private:
 	FuelManagement fuelManagement;
     FuelDisplay fuelDisplay;
 	ManifoldPressure manifoldPressure;
-	QFile *logFile;
+	FlightLog flightLog;
     QSettings settings;
     QSettings gaugeSettings;
     QString sensorInterfaceType;
     AlarmBox alarmWindow;
+    AlarmEngine alarmEngine;
+    int rpmAlarm;
+    int chtAlarm;
+    QMap<int, BarGraph*> barGraphAlarms;
     int warmupTemp;
     QTimer flashTimer;
+    FrameScheduler *frameScheduler;
+    PaintProfiler *paintProfiler;
     ChtEgt chtEgt;
     ButtonBar buttonBar;
     QCustomPlot *customPlot;
     QCPGraph *graphic;
-    QTimer dataTimer;
+    QGraphicsProxyWidget *trendPage;
+    QTimer trendReplotTimer;
+    TrendBuffer chtTrend[4];
+    TrendPyramid trendHistory;
+    bool trendWholeFlight;
+    QElapsedTimer trendClock;
     //QUdpSocket *socket;
     WindVector windVector;
     QTimer clockTimer;
@@ -100,17 +124,20 @@ private:
 
 private slots:
 	void demoFunction();
-    void writeLogFile();
     void realtimeDataSlot();
+    void onAlarmStateChanged(int source);
 
 public slots:
 	void setTimeToDestination(double time);
 	void userMessageHandler(QString title, QString content, bool endApplication);
     void showStatusMessage(QString text, QColor color);
-    void setValuesBulkUpdate(qreal rpm, qreal fuelFlow, qreal oilTemp, qreal oilPress, qreal amps, qreal volts, qreal egt1, qreal egt2, qreal egt3, qreal egt4, qreal cht1, qreal cht2, qreal cht3, qreal cht4, qreal oat, qreal iat);
+    void processSample(const EngineSample &sample);
+    void setValuesBulkUpdate(const EngineSample &sample);
     void setFuelData(double fuelFlowValue, double fuelAbsoluteValue);
     void processPendingDatagrams();
     void onUpdateWindInfo(float spd, float dir, float mHdg);
+    void setTrendWholeFlight(bool wholeFlight);
+    void showTrendPage(bool visible);
 
 };
 
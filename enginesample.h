@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ENGINESAMPLE_H
+#define ENGINESAMPLE_H
+
+#include <QtCore>
+
+//! Engine Channels
+/*!
+ * The first sixteen channels are in the order of the fields of the sensor interface's data string.
+*/
+
+enum EngineChannel {
+	ChannelRpm,
+	ChannelFuelFlow,
+	ChannelOilTemp,
+	ChannelOilPress,
+	ChannelAmps,
+	ChannelVolts,
+	ChannelEgt1,
+	ChannelEgt2,
+	ChannelEgt3,
+	ChannelEgt4,
+	ChannelCht1,
+	ChannelCht2,
+	ChannelCht3,
+	ChannelCht4,
+	ChannelOat,
+	ChannelIat,
+	ChannelManifoldPressure,
+	ChannelFuelPress,
+	ChannelCoolantTemp,
+	ChannelFuelLevel1,
+	ChannelFuelLevel2,
+	ChannelRpm2,
+	ChannelFuelFlow2,
+	ChannelAux1,
+	ChannelAux2,
+	ChannelInternalTemp,
+	ChannelEgt5,
+	ChannelEgt6,
+	ChannelCht5,
+	ChannelCht6,
+	ChannelCount
+};
+
+//! Engine Sample
+/*!
+ * One converted set of engine values, as shown on the display, written to the log and checked
+ * for alarms. Only channels whose bit is set in validMask carry a value, all others were not
+ * delivered by the sensor interface or could not be converted.
+*/
+
+struct EngineSample
+{
+	EngineSample() : timestamp(0), validMask(0)
+	{
+		for(int i = 0; i < ChannelCount; ++i)
+		{
+			value[i] = 0.0;
+		}
+	}
+	bool isValid(EngineChannel channel) const {return validMask & (1u << channel);}
+	void set(EngineChannel channel, qreal newValue) {value[channel] = newValue; validMask |= 1u << channel;}
+	void invalidate(EngineChannel channel) {validMask &= ~(1u << channel);}
+	qint64 timestamp; // Milliseconds since epoch, UTC
+	qreal value[ChannelCount];
+	quint32 validMask;
+};
+
+Q_STATIC_ASSERT(ChannelCount <= 32);
+Q_DECLARE_METATYPE(EngineSample)
+
+#endif // ENGINESAMPLE_H
@@ -231,7 +231,6 @@ void ExhaustGasTemperature::paint(QPainter *painter, const QStyleOptionGraphicsI
                 //If in normal mode, just draw the readout
                 painter->drawText(textRect, Qt::AlignCenter, QString::number(currentValues.at(i), 'f', 0));
             }
-            update();
 		}
 	}
 
@@ -371,4 +370,9 @@ void ExhaustGasTemperature::changeFlashState()
     } else {
         flashState = false;
     }
+
+    //  Only an alarmed readout looks different in the new phase
+    if (isAlarmedRed || isAlarmedYellow) {
+        update();
+    }
 }
@@ -0,0 +1,394 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "flightlog.h"
+#include <QtEndian>
+#include <cstring>
+
+const char FlightLog::magic[8] = {'E', 'M', 'S', 'L', 'O', 'G', '0', '2'};
+
+// Names as in the former CSV log, in the order of EngineChannel
+static const FlightLogChannel flightLogChannels[] = {
+	{"RPM", 0, "RPM"},
+	{"FF", "Units/fuelFlow", "GPH"},
+	{"OILT", "Units/temp", "F"},
+	{"OILP", "Units/pressure", "PSI"},
+	{"CUR", 0, "A"},
+	{"BAT", 0, "V"},
+	{"EGT1", "Units/temp", "F"},
+	{"EGT2", "Units/temp", "F"},
+	{"EGT3", "Units/temp", "F"},
+	{"EGT4", "Units/temp", "F"},
+	{"CHT1", "Units/temp", "F"},
+	{"CHT2", "Units/temp", "F"},
+	{"CHT3", "Units/temp", "F"},
+	{"CHT4", "Units/temp", "F"},
+	{"OAT", "Units/temp", "F"},
+	{"IAT", "Units/temp", "F"},
+	{"MAP", 0, "inHg"},
+	{"FUELP", "Units/pressure", "PSI"},
+	{"COOLANT", "Units/temp", "F"},
+	{"FUEL1", "Units/fuel", "GAL"},
+	{"FUEL2", "Units/fuel", "GAL"},
+	{"RPM2", 0, "RPM"},
+	{"FF2", "Units/fuelFlow", "GPH"},
+	{"AUX1", 0, ""},
+	{"AUX2", 0, ""},
+	{"INTT", 0, "C"},
+	{"EGT5", "Units/temp", "F"},
+	{"EGT6", "Units/temp", "F"},
+	{"CHT5", "Units/temp", "F"},
+	{"CHT6", "Units/temp", "F"}
+};
+
+Q_STATIC_ASSERT(sizeof(flightLogChannels) / sizeof(flightLogChannels[0]) == ChannelCount);
+
+FlightLog::FlightLog(QObject *parent) : QObject(parent)
+  , sampleInterval(0)
+  , lastSample(0)
+  , blockStart(0)
+  , pending(0)
+{
+	// A partly filled block is written after a few seconds at the latest
+	connect(&flushTimer, SIGNAL(timeout()), this, SLOT(flush()));
+}
+
+FlightLog::~FlightLog()
+{
+	close();
+}
+
+const FlightLogChannel &FlightLog::channel(EngineChannel channel)
+{
+	return flightLogChannels[channel];
+}
+
+/*! \brief Creates the log and writes its header, describing the aircraft and the channels from settings
+*/
+bool FlightLog::open(const QString &fileName, const QSettings &settings)
+{
+	close();
+	file.setFileName(fileName);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Unbuffered))
+	{
+		return false;
+	}
+
+	QStringList header;
+	header << QString("created=%1").arg(QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+	header << QString("callSign=%1").arg(settings.value("Aircraft/CALL_SIGN").toString());
+	header << QString("aircraftModel=%1").arg(settings.value("Aircraft/AIRCRAFT_MODEL").toString());
+	header << QString("aircraftSerial=%1").arg(settings.value("Aircraft/AIRCRAFT_SN").toString());
+	header << QString("engineType=%1").arg(settings.value("Aircraft/ENGINE_TYPE").toString());
+	header << QString("engineSerial=%1").arg(settings.value("Aircraft/ENGINE_SN").toString());
+	header << QString("hobbs=%1").arg(settings.value("Time/hobbs", 0.0).toDouble());
+	header << QString("channels=%1").arg(int(ChannelCount));
+	for(int i = 0; i < ChannelCount; ++i)
+	{
+		const FlightLogChannel &logChannel = flightLogChannels[i];
+		const QString unit = logChannel.unitKey ? settings.value(logChannel.unitKey, logChannel.unit).toString() : QString(logChannel.unit);
+		header << QString("channel.%1=%2;%3").arg(i).arg(logChannel.name, unit);
+	}
+	const QByteArray text = header.join('\n').append('\n').toUtf8();
+
+	QByteArray start(magic, sizeof(magic));
+	start.resize(sizeof(magic) + 4);
+	qToLittleEndian<quint32>(text.size(), reinterpret_cast<uchar *>(start.data()) + sizeof(magic));
+	start.append(text);
+	if(file.write(start) != start.size())
+	{
+		file.close();
+		return false;
+	}
+
+	pending = 0;
+	lastSample = 0;
+	flushTimer.start(5000);
+	return true;
+}
+
+void FlightLog::close()
+{
+	if(file.isOpen())
+	{
+		flush();
+		file.close();
+	}
+	flushTimer.stop();
+}
+
+/*! \brief Adds the sample and the hour meter readings to the current block, the block is written when it is full
+*
+* With a sample interval set, samples closer than that to the last logged one are skipped.
+*/
+void FlightLog::addSample(const EngineSample &sample, quint32 hobbsSeconds, quint32 flightSeconds)
+{
+	if(!file.isOpen())
+	{
+		return;
+	}
+	const qint64 timestamp = sample.timestamp ? sample.timestamp : QDateTime::currentMSecsSinceEpoch();
+	if(lastSample && timestamp - lastSample < sampleInterval)
+	{
+		return;
+	}
+	lastSample = timestamp;
+
+	// A block spans at most 2^32 ms, a clock going backwards starts a new one
+	if(pending && (timestamp < blockStart || timestamp - blockStart > Q_INT64_C(0xFFFFFFFF)))
+	{
+		flush();
+	}
+	if(pending == 0)
+	{
+		blockStart = timestamp;
+	}
+	offsets[pending] = quint32(timestamp - blockStart);
+	validMasks[pending] = sample.validMask;
+	hobbsTimes[pending] = hobbsSeconds;
+	flightTimes[pending] = flightSeconds;
+	for(int i = 0; i < ChannelCount; ++i)
+	{
+		values[i][pending] = float(sample.value[i]);
+	}
+	if(++pending == blockCapacity)
+	{
+		flush();
+	}
+}
+
+/*! \brief Writes the pending samples as one block with a single write
+*/
+void FlightLog::flush()
+{
+	if(pending == 0 || !file.isOpen())
+	{
+		return;
+	}
+
+	block.resize(blockHeaderSize + pending * (16 + 4 * ChannelCount));
+	uchar *out = reinterpret_cast<uchar *>(block.data());
+	qToLittleEndian<quint32>(blockMagic, out);
+	qToLittleEndian<quint16>(pending, out + 4);
+	qToLittleEndian<quint16>(ChannelCount, out + 6);
+	qToLittleEndian<qint64>(blockStart, out + 8);
+	out += blockHeaderSize;
+	for(int i = 0; i < pending; ++i, out += 4)
+	{
+		qToLittleEndian<quint32>(offsets[i], out);
+	}
+	for(int i = 0; i < pending; ++i, out += 4)
+	{
+		qToLittleEndian<quint32>(validMasks[i], out);
+	}
+	for(int i = 0; i < pending; ++i, out += 4)
+	{
+		qToLittleEndian<quint32>(hobbsTimes[i], out);
+	}
+	for(int i = 0; i < pending; ++i, out += 4)
+	{
+		qToLittleEndian<quint32>(flightTimes[i], out);
+	}
+	for(int channel = 0; channel < ChannelCount; ++channel)
+	{
+		for(int i = 0; i < pending; ++i, out += 4)
+		{
+			quint32 bits;
+			memcpy(&bits, &values[channel][i], sizeof(bits));
+			qToLittleEndian<quint32>(bits, out);
+		}
+	}
+
+	if(file.write(block) != block.size())
+	{
+		qWarning() << "Unable to write the flight log:" << file.errorString();
+	}
+	pending = 0;
+}
+
+FlightLogReader::FlightLogReader() : blockStart(0)
+  , blockSamples(0)
+  , blockChannels(0)
+  , position(0)
+{
+}
+
+/*! \brief Opens a log and reads its header and channel schema
+*/
+bool FlightLogReader::open(const QString &fileName)
+{
+	file.setFileName(fileName);
+	if(!file.open(QIODevice::ReadOnly))
+	{
+		error = file.errorString();
+		return false;
+	}
+
+	const QByteArray start = file.read(sizeof(FlightLog::magic) + 4);
+	if(start.size() != int(sizeof(FlightLog::magic) + 4) || !start.startsWith(QByteArray(FlightLog::magic, sizeof(FlightLog::magic))))
+	{
+		error = "Not a flight log";
+		return false;
+	}
+	const quint32 length = qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(start.constData()) + sizeof(FlightLog::magic));
+	const QByteArray text = file.read(length);
+	if(quint32(text.size()) != length)
+	{
+		error = "Truncated header";
+		return false;
+	}
+
+	headerFields.clear();
+	channelNames.clear();
+	channelUnits.clear();
+	channelMap.clear();
+	foreach(const QString &line, QString::fromUtf8(text).split('\n', QString::SkipEmptyParts))
+	{
+		const int separator = line.indexOf('=');
+		if(separator < 0)
+		{
+			continue;
+		}
+		const QString key = line.left(separator);
+		const QString value = line.mid(separator + 1);
+		if(key.startsWith("channel."))
+		{
+			const int index = key.mid(8).toInt();
+			if(index != channelNames.size())
+			{
+				error = "Channel schema out of order";
+				return false;
+			}
+			channelNames << value.section(';', 0, 0);
+			channelUnits << value.section(';', 1);
+			int engineChannel = -1;
+			for(int i = 0; i < ChannelCount; ++i)
+			{
+				if(channelNames.last() == flightLogChannels[i].name)
+				{
+					engineChannel = i;
+					break;
+				}
+			}
+			channelMap << engineChannel;
+		}
+		else
+		{
+			headerFields << qMakePair(key, value);
+		}
+	}
+
+	blockSamples = 0;
+	position = 0;
+	return true;
+}
+
+QString FlightLogReader::headerValue(const QString &key) const
+{
+	for(int i = 0; i < headerFields.size(); ++i)
+	{
+		if(headerFields.at(i).first == key)
+		{
+			return headerFields.at(i).second;
+		}
+	}
+	return QString();
+}
+
+bool FlightLogReader::readBlock()
+{
+	const QByteArray head = file.read(FlightLog::blockHeaderSize);
+	if(head.size() != FlightLog::blockHeaderSize)
+	{
+		if(!head.isEmpty())
+		{
+			error = "Truncated block";
+		}
+		return false;
+	}
+	const uchar *in = reinterpret_cast<const uchar *>(head.constData());
+	if(qFromLittleEndian<quint32>(in) != FlightLog::blockMagic)
+	{
+		error = "Corrupt block";
+		return false;
+	}
+	blockSamples = qFromLittleEndian<quint16>(in + 4);
+	blockChannels = qFromLittleEndian<quint16>(in + 6);
+	blockStart = qFromLittleEndian<qint64>(in + 8);
+	if(blockSamples == 0 || blockSamples > FlightLog::blockCapacity || blockChannels > 32)
+	{
+		blockSamples = 0;
+		error = "Corrupt block";
+		return false;
+	}
+
+	const int size = blockSamples * (16 + 4 * blockChannels);
+	block = file.read(size);
+	if(block.size() != size)
+	{
+		// The last block of a log that was not closed may be cut short
+		blockSamples = 0;
+		error = "Truncated block";
+		return false;
+	}
+	position = 0;
+	return true;
+}
+
+/*! \brief Reads the next sample and optionally its hour meter readings, returns false at the end of the log
+*/
+bool FlightLogReader::next(EngineSample *sample, quint32 *hobbsSeconds, quint32 *flightSeconds)
+{
+	while(position >= blockSamples)
+	{
+		if(!readBlock())
+		{
+			return false;
+		}
+	}
+
+	const uchar *in = reinterpret_cast<const uchar *>(block.constData());
+	const int i = position++;
+	*sample = EngineSample();
+	sample->timestamp = blockStart + qFromLittleEndian<quint32>(in + 4 * i);
+	const quint32 validMask = qFromLittleEndian<quint32>(in + 4 * (blockSamples + i));
+	if(hobbsSeconds)
+	{
+		*hobbsSeconds = qFromLittleEndian<quint32>(in + 4 * (2 * blockSamples + i));
+	}
+	if(flightSeconds)
+	{
+		*flightSeconds = qFromLittleEndian<quint32>(in + 4 * (3 * blockSamples + i));
+	}
+	const uchar *columns = in + 16 * blockSamples;
+	for(int channel = 0; channel < blockChannels && channel < channelMap.size(); ++channel)
+	{
+		const int engineChannel = channelMap.at(channel);
+		if(engineChannel < 0 || !(validMask & (1u << channel)))
+		{
+			continue;
+		}
+		const quint32 bits = qFromLittleEndian<quint32>(columns + 4 * (channel * blockSamples + i));
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		sample->set(EngineChannel(engineChannel), value);
+	}
+	return true;
+}
@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef FLIGHTLOG_H
+#define FLIGHTLOG_H
+
+#include <QtCore>
+#include "enginesample.h"
+
+//! Flight Log Format
+/*!
+ * A log starts with the magic "EMSLOG02", a little endian 32 bit length and a UTF-8 text
+ * header of key=value lines: aircraft, engine, Hobbs time at start and the channel schema as
+ * channel.<index>=<name>;<unit>. The samples follow in blocks, each written with one write:
+ *
+ *   quint32 magic "EBLK", quint16 sample count n, quint16 channel count c (at most 32),
+ *   qint64 timestamp of the first sample in ms since epoch, UTC,
+ *   n x quint32 ms after the first sample, n x quint32 valid mask (bit = channel index),
+ *   n x quint32 Hobbs time in s, n x quint32 flight time in s,
+ *   c x n x float32 values, one column per channel.
+ *
+ * All numbers are little endian. FlightLogReader reads it back, e.g. for the CSV exporter.
+*/
+
+struct FlightLogChannel
+{
+	const char *name;
+	const char *unitKey; // Units/... setting the channel is shown in, or 0 for a fixed unit
+	const char *unit; // Fixed unit, or the default of unitKey
+};
+
+class FlightLog : public QObject
+{
+	Q_OBJECT
+public:
+	explicit FlightLog(QObject *parent = 0);
+	~FlightLog();
+	bool open(const QString &fileName, const QSettings &settings);
+	void close();
+	bool isOpen() const {return file.isOpen();}
+	QString errorString() const {return file.errorString();}
+	void setSampleInterval(qint64 milliseconds) {sampleInterval = milliseconds;}
+	void addSample(const EngineSample &sample, quint32 hobbsSeconds = 0, quint32 flightSeconds = 0);
+	static const FlightLogChannel &channel(EngineChannel channel);
+	enum {
+		blockCapacity = 64,
+		blockHeaderSize = 16
+	};
+	static const char magic[8];
+	static const quint32 blockMagic = 0x4B4C4245; // "EBLK"
+public slots:
+	void flush();
+private:
+	QFile file;
+	QTimer flushTimer;
+	qint64 sampleInterval;
+	qint64 lastSample;
+	qint64 blockStart;
+	int pending;
+	quint32 offsets[blockCapacity];
+	quint32 validMasks[blockCapacity];
+	quint32 hobbsTimes[blockCapacity];
+	quint32 flightTimes[blockCapacity];
+	float values[ChannelCount][blockCapacity];
+	QByteArray block; // Reused for every write
+};
+
+//! Flight Log Reader Class
+/*!
+ * Reads a log written by FlightLog one sample at a time. Channels are matched to this build's
+ * EngineChannel by name, channels it does not know are skipped.
+*/
+
+class FlightLogReader
+{
+public:
+	FlightLogReader();
+	bool open(const QString &fileName);
+	QString errorString() const {return error;}
+	const QList<QPair<QString, QString> > &header() const {return headerFields;}
+	QString headerValue(const QString &key) const;
+	int channelCount() const {return channelNames.size();}
+	QString channelName(int index) const {return channelNames.at(index);}
+	QString channelUnit(int index) const {return channelUnits.at(index);}
+	int engineChannel(int index) const {return channelMap.at(index);} // -1 if unknown
+	bool next(EngineSample *sample, quint32 *hobbsSeconds = 0, quint32 *flightSeconds = 0);
+private:
+	bool readBlock();
+	QFile file;
+	QString error;
+	QList<QPair<QString, QString> > headerFields;
+	QStringList channelNames;
+	QStringList channelUnits;
+	QVector<int> channelMap;
+	QByteArray block;
+	qint64 blockStart;
+	int blockSamples;
+	int blockChannels;
+	int position;
+};
+
+#endif // FLIGHTLOG_H
@@ -0,0 +1,70 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "framescheduler.h"
+
+FrameScheduler::FrameScheduler(QGraphicsView *graphicsView, QObject *parent) : QObject(parent)
+  , view(graphicsView)
+  , frameInterval(33)
+  , frameCount(0)
+{
+	// The view no longer repaints by itself, changes of the scene are routed through here
+	view->setViewportUpdateMode(QGraphicsView::NoViewportUpdate);
+	connect(view->scene(), SIGNAL(changed(QList<QRectF>)), this, SLOT(sceneChanged(QList<QRectF>)));
+
+	frameTimer.setSingleShot(true);
+	connect(&frameTimer, SIGNAL(timeout()), this, SLOT(paintFrame()));
+	lastFrame.start();
+
+	QSettings settings("settings/settings.ini", QSettings::IniFormat);
+	setMaximumFps(settings.value("Display/maxFps", 30).toInt());
+}
+
+void FrameScheduler::setMaximumFps(int fps)
+{
+	frameInterval = 1000 / qBound(1, fps, 1000);
+}
+
+/*! \brief Collects the changed areas and schedules the next frame
+*
+* The frame is painted right away if the last one is at least one frame interval ago,
+* otherwise when the interval is over. Further changes until then are painted with it.
+*/
+void FrameScheduler::sceneChanged(const QList<QRectF> &region)
+{
+	foreach(const QRectF &rect, region)
+	{
+		// Antialiased edges may reach one pixel beyond the item's bounding rectangle
+		dirtyRegion += view->mapFromScene(rect).boundingRect().adjusted(-2, -2, 2, 2);
+	}
+	if(dirtyRegion.isEmpty() || frameTimer.isActive())
+	{
+		return;
+	}
+	frameTimer.start(qMax<qint64>(0, frameInterval - lastFrame.elapsed()));
+}
+
+void FrameScheduler::paintFrame()
+{
+	view->viewport()->update(dirtyRegion);
+	dirtyRegion = QRegion();
+	lastFrame.restart();
+	++frameCount;
+}
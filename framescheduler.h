@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <QtWidgets>
+
+//! Frame Scheduler Class
+/*!
+ * This class takes over repainting of a graphics view. Gauges only call update() when their
+ * value, alarm state or flash phase changed; the areas the scene reports as changed are
+ * collected and repainted together at most once per frame, limited to Display/maxFps. When
+ * nothing changes, nothing is painted.
+*/
+
+class FrameScheduler : public QObject
+{
+	Q_OBJECT
+public:
+	explicit FrameScheduler(QGraphicsView *graphicsView, QObject *parent = 0);
+	void setMaximumFps(int fps);
+	int maximumFps() const {return 1000 / frameInterval;}
+	quint64 framesPainted() const {return frameCount;}
+private:
+	QGraphicsView *view;
+	QRegion dirtyRegion;
+	QTimer frameTimer;
+	QElapsedTimer lastFrame;
+	int frameInterval; // Milliseconds
+	quint64 frameCount;
+private slots:
+	void sceneChanged(const QList<QRectF> &region);
+	void paintFrame();
+};
+
+#endif // FRAMESCHEDULER_H
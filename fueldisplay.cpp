@@ -19,6 +19,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "fueldisplay.h"
+#include "paintprofiler.h"
 
 FuelDisplay::FuelDisplay(QGraphicsObject *parent)
     : QGraphicsObject(parent)
@@ -48,6 +49,7 @@ QRectF FuelDisplay::boundingRect() const
 */
 void FuelDisplay::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+    PaintProfiler::Scope profile(this);
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
@@ -96,12 +98,18 @@ void FuelDisplay::paint(QPainter *painter, const QStyleOptionGraphicsItem *optio
 
 void FuelDisplay::setFuelFlow(double value)
 {
-    fuelFlow = value;
+    if (value != fuelFlow) {
+        fuelFlow = value;
+        update();
+    }
 }
 
 void FuelDisplay::setTimeToDestination(double time)
 {
-    timeToDestination = time;
+    if (time != timeToDestination) {
+        timeToDestination = time;
+        update();
+    }
 }
 
 void FuelDisplay::onFuelAmountChange(QString changeDirection) {
@@ -110,9 +118,11 @@ void FuelDisplay::onFuelAmountChange(QString changeDirection) {
     } else {
         fuelAmount--;
     }
+    update();
 }
 
 void FuelDisplay::applyFuelBurn() {
     fuelAmount = fuelAmount - (fuelFlow * (t.elapsed() * 0.000000277778));
     t.restart();
+    update();
 }
@@ -19,6 +19,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "fuelmanagement.h"
+#include "paintprofiler.h"
 
 FuelManagement::FuelManagement(QGraphicsObject *parent)
 	: QGraphicsObject(parent)
@@ -56,6 +57,7 @@ QRectF FuelManagement::boundingRect() const
 */
 void FuelManagement::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+	PaintProfiler::Scope profile(this);
 	Q_UNUSED(option);
 	Q_UNUSED(widget);
 
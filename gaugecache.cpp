@@ -0,0 +1,65 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "gaugecache.h"
+
+GaugeCache::GaugeCache() : scale(0.0)
+  , valid(false)
+{
+}
+
+/*! \brief Returns the number of device pixels per item unit the painter draws with
+*/
+qreal GaugeCache::deviceScale(const QPainter *painter)
+{
+	const QTransform transform = painter->deviceTransform();
+	return qSqrt(transform.m11() * transform.m11() + transform.m12() * transform.m12()) * painter->device()->devicePixelRatioF();
+}
+
+bool GaugeCache::isValid(const QPainter *painter) const
+{
+	return valid && qFuzzyCompare(scale, deviceScale(painter));
+}
+
+/*! \brief Opens cachePainter on a new, transparent pixmap covering rect in item coordinates
+*
+* Pen, font and render hints are taken over from painter. The cache is valid again once
+* cachePainter has finished drawing the static layer.
+*/
+void GaugeCache::beginUpdate(QPainter *cachePainter, const QPainter *painter, const QRectF &rect)
+{
+	scale = deviceScale(painter);
+	area = rect;
+	pixmap = QPixmap((rect.size() * scale).toSize().expandedTo(QSize(1, 1)));
+	pixmap.setDevicePixelRatio(scale);
+	pixmap.fill(Qt::transparent);
+
+	cachePainter->begin(&pixmap);
+	cachePainter->setRenderHints(painter->renderHints());
+	cachePainter->setFont(painter->font());
+	cachePainter->setPen(painter->pen());
+	cachePainter->translate(-rect.topLeft());
+	valid = true;
+}
+
+void GaugeCache::draw(QPainter *painter) const
+{
+	painter->drawPixmap(area.topLeft(), pixmap);
+}
@@ -0,0 +1,49 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAUGECACHE_H
+#define GAUGECACHE_H
+
+#include <QtWidgets>
+
+//! Gauge Cache Class
+/*!
+ * Holds the static layer of a gauge (ranges, ticks, labels) as a pixmap at device resolution,
+ * so a repaint only composites it and draws the moving parts on top. The gauge invalidates
+ * the cache whenever its configuration changes; a changed scale of the view rebuilds it too.
+*/
+
+class GaugeCache
+{
+public:
+	GaugeCache();
+	void invalidate() {valid = false;}
+	bool isValid(const QPainter *painter) const;
+	void beginUpdate(QPainter *cachePainter, const QPainter *painter, const QRectF &rect);
+	void draw(QPainter *painter) const;
+private:
+	static qreal deviceScale(const QPainter *painter);
+	QPixmap pixmap;
+	QRectF area;
+	qreal scale;
+	bool valid;
+};
+
+#endif // GAUGECACHE_H
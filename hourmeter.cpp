@@ -19,6 +19,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "hourmeter.h"
+#include "paintprofiler.h"
 
 HourMeter::HourMeter(QGraphicsObject *parent) : QGraphicsObject(parent), settings("settings/settings.ini", QSettings::IniFormat, parent)
 {
@@ -49,6 +50,7 @@ QRectF HourMeter::boundingRect() const
 */
 void HourMeter::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+    PaintProfiler::Scope profile(this);
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
@@ -139,6 +141,14 @@ QString HourMeter::getHobbsTime() {
     return hobbsString;
 }
 
+quint32 HourMeter::getFlightSeconds() const {
+    return quint32(flight.hour) * 3600 + flight.min * 60 + flight.sec;
+}
+
+quint32 HourMeter::getHobbsSeconds() const {
+    return quint32(hobbs.hour) * 3600 + hobbs.min * 60 + hobbs.sec;
+}
+
 void HourMeter::setEngineOn(bool state) {
     engineState = state;
 }
@@ -13,6 +13,8 @@ public:
 
     QString getFlightTime();
     QString getHobbsTime();
+    quint32 getFlightSeconds() const;
+    quint32 getHobbsSeconds() const;
 
     void setEngineOn(bool state);
 
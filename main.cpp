@@ -76,6 +76,8 @@ int main(int argc, char *argv[])
 {
 	QApplication a(argc, argv);
 
+    qRegisterMetaType<EngineSample>("EngineSample");
+
     QApplication::setOverrideCursor(Qt::BlankCursor);
 
     QApplication::setOrganizationName("Cardinal Avionics");
@@ -133,9 +135,17 @@ int main(int argc, char *argv[])
 //#endif
 	splash.finish(&engineMonitor);
 
-    //Create the RDAC connector
-    RDACconnect rdac;
-    rdac.openSerialPort();
+    //Create the RDAC connector and run serial reading and decoding in its own thread
+    //The port and the capture are closed in that thread before it stops, and the connector
+    //is deleted there as well, since its port, notifiers and timers belong to it
+    QThread rdacThread;
+    RDACconnect *rdac = new RDACconnect;
+    rdac->moveToThread(&rdacThread);
+    a.connect(&rdacThread, SIGNAL(started()), rdac, SLOT(openSerialPort()));
+    a.connect(&a, SIGNAL(aboutToQuit()), rdac, SLOT(closeSerialPort()), Qt::BlockingQueuedConnection);
+    a.connect(&a, SIGNAL(aboutToQuit()), &rdacThread, SLOT(quit()));
+    a.connect(&rdacThread, SIGNAL(finished()), rdac, SLOT(deleteLater()));
+    rdacThread.start();
 
 	NMEAconnect nmeaConnect;
 	a.connect(&nmeaConnect, SIGNAL(userMessage(QString,QString,bool)), &engineMonitor, SLOT(userMessageHandler(QString,QString,bool)));
@@ -147,8 +157,9 @@ int main(int argc, char *argv[])
     SensorConvert sensorConvert;
     //a.connect(&sensorConvert, SIGNAL(userMessage(QString,QString,bool)), &engineMonitor, 
 //SLOT(userMessageHandler(QString,QString,bool)));
-    a.connect(&sensorConvert, SIGNAL(updateMonitor(qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal)), &engineMonitor, SLOT(setValuesBulkUpdate(qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal,qreal)));
-    a.connect(&rdac, SIGNAL(rdacUpdateMessage(qreal,qreal)), &sensorConvert, SLOT(onRdacUpdate(qreal,qreal)));
+    a.connect(&sensorConvert, SIGNAL(sampleConverted(EngineSample)), &engineMonitor, SLOT(processSample(EngineSample)));
+    a.connect(&sensorConvert, SIGNAL(updateMonitor(EngineSample)), &engineMonitor, SLOT(setValuesBulkUpdate(EngineSample)));
+    sensorConvert.setRdacSampleQueue(rdac->sampleQueue());
     //a.connect(&sensorConvert, SIGNAL(updateFuelData(double,double)), &engineMonitor,
 //SLOT(setFuelData(double,double)));
     //a.connect(&sensorConvert, SIGNAL(statusMessage(QString,QColor)), &engineMonitor, 
@@ -158,7 +169,7 @@ int main(int argc, char *argv[])
 //port of choice
     //PortListener listener(portName);        // signals get hooked up internally
     //a.connect(&listener, SIGNAL(sendData(QString)), &sensorConvert, 
-//SLOT(processData(QString)));
+//SLOT(processData(QByteArray)));
 
     flightCalculator flightCalc;
     QTimer *flightTimer = new QTimer();
@@ -186,5 +197,7 @@ int main(int argc, char *argv[])
 
     //spatial testDB;
 
-	return a.exec();
+	int result = a.exec();
+	rdacThread.wait();
+	return result;
 }
@@ -0,0 +1,205 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "paintprofiler.h"
+#include <algorithm>
+
+PaintProfiler *PaintProfiler::current = Q_NULLPTR;
+
+PaintProfiler::PaintProfiler(QGraphicsObject *parent) : QGraphicsObject(parent)
+  , overlayTime(0)
+  , frameBudget(33333333)
+  , framesOverBudget(0)
+  , font("Monospace", 8)
+{
+	current = this;
+
+	// Always on top, the overlay is refreshed once a second instead of with every frame
+	setZValue(1000.0);
+	font.setStyleHint(QFont::TypeWriter);
+	connect(&refreshTimer, SIGNAL(timeout()), this, SLOT(refreshOverlay()));
+	refreshTimer.start(1000);
+}
+
+PaintProfiler::~PaintProfiler()
+{
+	if(current == this)
+	{
+		current = Q_NULLPTR;
+	}
+}
+
+QRectF PaintProfiler::boundingRect() const
+{
+	return QRectF(0, 0, 330, 14 + 11 * overlayLines.size());
+}
+
+void PaintProfiler::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+	Q_UNUSED(option);
+	Q_UNUSED(widget);
+
+	// Not part of what is measured, its time is taken out of the frame again
+	QElapsedTimer timer;
+	timer.start();
+
+	painter->setPen(Qt::NoPen);
+	painter->setBrush(QColor(0, 0, 0, 200));
+	painter->drawRect(boundingRect());
+	painter->setFont(font);
+	for(int i = 0; i < overlayLines.size(); ++i)
+	{
+		painter->setPen(i == 0 && framesOverBudget ? Qt::yellow : Qt::white);
+		painter->drawText(QPointF(5, 16 + 11 * i), overlayLines.at(i));
+	}
+
+	overlayTime += timer.nsecsElapsed();
+}
+
+void PaintProfiler::setFrameBudget(qreal milliseconds)
+{
+	frameBudget = qint64(milliseconds * 1e6);
+}
+
+void PaintProfiler::beginFrame()
+{
+	overlayTime = 0;
+	frameTimer.start();
+}
+
+void PaintProfiler::endFrame()
+{
+	const qint64 nsecs = frameTimer.nsecsElapsed() - overlayTime;
+	frames.add(nsecs);
+	if(nsecs > frameBudget)
+	{
+		++framesOverBudget;
+	}
+}
+
+void PaintProfiler::addItemSample(const QGraphicsObject *item, qint64 nsecs)
+{
+	QHash<const QGraphicsObject *, History>::iterator history = items.find(item);
+	if(history == items.end())
+	{
+		// Named once, the name stays readable in the report after the item is gone
+		QString name = item->metaObject()->className();
+		if(!item->objectName().isEmpty())
+		{
+			name.append(' ').append(item->objectName());
+		}
+		itemNames.insert(item, name);
+		history = items.insert(item, History());
+	}
+	history->add(nsecs);
+}
+
+void PaintProfiler::History::add(qint64 nsecs)
+{
+	samples[next] = nsecs;
+	next = (next + 1) % sampleCount;
+	count = qMin(count + 1, int(sampleCount));
+	++paints;
+	worst = qMax(worst, nsecs);
+}
+
+/*! \brief Returns the percentile of the samples in the window, 100 returns the maximum
+*/
+qint64 PaintProfiler::History::percentile(int percent) const
+{
+	if(count == 0)
+	{
+		return 0;
+	}
+	qint64 sorted[sampleCount];
+	std::copy(samples, samples + count, sorted);
+	qint64 *nth = sorted + (count - 1) * percent / 100;
+	std::nth_element(sorted, nth, sorted + count);
+	return *nth;
+}
+
+QString PaintProfiler::formatLine(const QString &name, const History &history) const
+{
+	return QString("%1 %2 %3 %4")
+			.arg(name.left(24), -24)
+			.arg(history.percentile(50) / 1e6, 6, 'f', 2)
+			.arg(history.percentile(99) / 1e6, 6, 'f', 2)
+			.arg(history.percentile(100) / 1e6, 6, 'f', 2);
+}
+
+/*! \brief Returns the statistics as text, one line per item after the frame, slowest first
+*/
+QString PaintProfiler::report() const
+{
+	QStringList lines;
+	lines << QString("%1 %2 %3 %4").arg("ms, last 256 paints", -24).arg("p50", 6).arg("p99", 6).arg("max", 6);
+	lines << formatLine("frame", frames);
+
+	QList<QPair<qint64, QString> > itemLines;
+	QHash<const QGraphicsObject *, History>::const_iterator history;
+	for(history = items.constBegin(); history != items.constEnd(); ++history)
+	{
+		itemLines.append(qMakePair(history->percentile(99), formatLine(itemNames.value(history.key()), history.value())));
+	}
+	std::sort(itemLines.begin(), itemLines.end());
+	for(int i = itemLines.size() - 1; i >= 0; --i)
+	{
+		lines << itemLines.at(i).second;
+	}
+	return lines.join('\n');
+}
+
+/*! \brief Writes the statistics of the window and the totals since start to fileName
+*/
+bool PaintProfiler::writeReport(const QString &fileName) const
+{
+	QFile file(fileName);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		return false;
+	}
+	QTextStream out(&file);
+	out << "Paint profile written " << QDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh:mm:ss") << " UTC\n";
+	out << "Frame budget " << QString::number(frameBudget / 1e6, 'f', 2) << " ms, " << framesOverBudget
+		<< " of " << frames.paints << " frames over budget, worst frame "
+		<< QString::number(frames.worst / 1e6, 'f', 2) << " ms\n\n";
+	out << report() << "\n\n";
+	out << "Paints and worst paint since start\n";
+	QHash<const QGraphicsObject *, History>::const_iterator history;
+	for(history = items.constBegin(); history != items.constEnd(); ++history)
+	{
+		out << QString("%1 %2 %3\n").arg(itemNames.value(history.key()), -24).arg(history->paints, 8)
+			.arg(history->worst / 1e6, 8, 'f', 2);
+	}
+	return true;
+}
+
+void PaintProfiler::refreshOverlay()
+{
+	QStringList lines = report().split('\n');
+	lines.prepend(QString("%1 of %2 frames over %3 ms budget").arg(framesOverBudget).arg(frames.paints)
+				  .arg(frameBudget / 1e6, 0, 'f', 1));
+	if(lines.size() != overlayLines.size())
+	{
+		prepareGeometryChange();
+	}
+	overlayLines = lines;
+	update();
+}
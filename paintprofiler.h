@@ -0,0 +1,103 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef PAINTPROFILER_H
+#define PAINTPROFILER_H
+
+#include <QtWidgets>
+
+//! Paint Profiler Class
+/*!
+ * This class measures how long every instrumented gauge takes to paint and how long the view
+ * takes for a whole frame. It is only created when Display/paintProfiler is set; without it a
+ * Scope costs a null pointer check. The last sampleCount paints of every item and of the frame
+ * are kept, their p50/p99/max are shown in an overlay on top of the scene and written to a
+ * report when the application closes.
+*/
+
+class PaintProfiler : public QGraphicsObject
+{
+	Q_OBJECT
+public:
+	//! Times one paint of an item from construction to destruction
+	class Scope
+	{
+	public:
+		explicit Scope(const QGraphicsObject *item) : profiler(current), item(item)
+		{
+			if(profiler)
+			{
+				timer.start();
+			}
+		}
+		~Scope()
+		{
+			if(profiler)
+			{
+				profiler->addItemSample(item, timer.nsecsElapsed());
+			}
+		}
+	private:
+		PaintProfiler *profiler;
+		const QGraphicsObject *item;
+		QElapsedTimer timer;
+	};
+
+	explicit PaintProfiler(QGraphicsObject *parent = 0);
+	~PaintProfiler();
+	QRectF boundingRect() const;
+	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
+	void setFrameBudget(qreal milliseconds);
+	void beginFrame();
+	void endFrame();
+	void addItemSample(const QGraphicsObject *item, qint64 nsecs);
+	QString report() const;
+	bool writeReport(const QString &fileName) const;
+
+private:
+	enum {sampleCount = 256};
+	struct History
+	{
+		History() : next(0), count(0), paints(0), worst(0) {}
+		void add(qint64 nsecs);
+		qint64 percentile(int percent) const;
+		qint64 samples[sampleCount];
+		int next;
+		int count;
+		quint64 paints;
+		qint64 worst; // Since start, samples only cover the window
+	};
+	static PaintProfiler *current;
+	QString formatLine(const QString &name, const History &history) const;
+	History frames;
+	QHash<const QGraphicsObject *, History> items;
+	QHash<const QGraphicsObject *, QString> itemNames;
+	QElapsedTimer frameTimer;
+	qint64 overlayTime; // Spent painting the overlay during the current frame
+	qint64 frameBudget; // Nanoseconds
+	quint64 framesOverBudget;
+	QStringList overlayLines;
+	QTimer refreshTimer;
+	QFont font;
+private slots:
+	void refreshOverlay();
+};
+
+#endif // PAINTPROFILER_H
@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "rdaccapture.h"
+
+static const char captureMagic[8] = {'R', 'D', 'A', 'C', 'C', 'A', 'P', 0};
+static const quint32 captureVersion = 1;
+static const int headerSize = sizeof(captureMagic) + sizeof(quint32);
+static const int recordHeaderSize = sizeof(quint64) + sizeof(quint16);
+
+RDACcaptureWriter::RDACcaptureWriter()
+{
+}
+
+RDACcaptureWriter::~RDACcaptureWriter()
+{
+	close();
+}
+
+bool RDACcaptureWriter::open(const QString &fileName)
+{
+	file.setFileName(fileName);
+	if(!file.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "Unable to open RDAC capture" << fileName << file.errorString();
+		return false;
+	}
+
+	char header[headerSize];
+	memcpy(header, captureMagic, sizeof(captureMagic));
+	qToLittleEndian<quint32>(captureVersion, reinterpret_cast<uchar *>(header + sizeof(captureMagic)));
+	file.write(header, headerSize);
+	return true;
+}
+
+void RDACcaptureWriter::close()
+{
+	if(file.isOpen())
+	{
+		file.close();
+	}
+}
+
+/*! \brief Appends one serial read to the capture
+*
+* Reads longer than a record can hold are split into several records with the same timestamp.
+*/
+void RDACcaptureWriter::write(quint64 timestamp, const char *data, int length)
+{
+	do
+	{
+		const quint16 recordLength = quint16(qMin(length, 0xFFFF));
+		uchar recordHeader[recordHeaderSize];
+		qToLittleEndian<quint64>(timestamp, recordHeader);
+		qToLittleEndian<quint16>(recordLength, recordHeader + sizeof(quint64));
+		file.write(reinterpret_cast<const char *>(recordHeader), recordHeaderSize);
+		file.write(data, recordLength);
+		data += recordLength;
+		length -= recordLength;
+	} while(length > 0);
+}
+
+RDACcaptureReader::RDACcaptureReader()
+{
+}
+
+bool RDACcaptureReader::open(const QString &fileName)
+{
+	file.setFileName(fileName);
+	if(!file.open(QIODevice::ReadOnly))
+	{
+		qWarning() << "Unable to open RDAC capture" << fileName << file.errorString();
+		return false;
+	}
+
+	char header[headerSize];
+	if(file.read(header, headerSize) != headerSize || memcmp(header, captureMagic, sizeof(captureMagic)) != 0)
+	{
+		qWarning() << fileName << "is not an RDAC capture";
+		file.close();
+		return false;
+	}
+	const quint32 version = qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(header + sizeof(captureMagic)));
+	if(version != captureVersion)
+	{
+		qWarning() << "Unsupported RDAC capture version" << version;
+		file.close();
+		return false;
+	}
+	return true;
+}
+
+void RDACcaptureReader::rewind()
+{
+	file.seek(headerSize);
+}
+
+/*! \brief Reads the next record
+*
+* data is resized to the record length, so reusing the same QByteArray avoids reallocating.
+* Returns false at the end of the capture or if the last record is truncated.
+*/
+bool RDACcaptureReader::next(quint64 &timestamp, QByteArray &data)
+{
+	uchar recordHeader[recordHeaderSize];
+	if(file.read(reinterpret_cast<char *>(recordHeader), recordHeaderSize) != recordHeaderSize)
+	{
+		return false;
+	}
+	timestamp = qFromLittleEndian<quint64>(recordHeader);
+	const int length = qFromLittleEndian<quint16>(recordHeader + sizeof(quint64));
+	data.resize(length);
+	return file.read(data.data(), length) == length;
+}
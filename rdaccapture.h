@@ -0,0 +1,64 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef RDACCAPTURE_H
+#define RDACCAPTURE_H
+
+#include <QtCore>
+
+//! RDAC Capture File
+/*!
+ * A capture is the raw byte stream received from the RDAC, stored exactly as it was read from
+ * the serial port. All numbers are little endian.
+ *
+ *   Header: "RDACCAP" 0x00, quint32 version
+ *   Record: quint64 timestamp in ns since start of capture (monotonic), quint16 length, bytes
+ *
+ * One record is written per serial read, so replaying a capture reproduces the original
+ * chunking as well as the timing.
+*/
+
+class RDACcaptureWriter
+{
+public:
+	RDACcaptureWriter();
+	~RDACcaptureWriter();
+	bool open(const QString &fileName);
+	void close();
+	bool isOpen() const {return file.isOpen();}
+	void write(quint64 timestamp, const char *data, int length);
+private:
+	QFile file;
+};
+
+class RDACcaptureReader
+{
+public:
+	RDACcaptureReader();
+	bool open(const QString &fileName);
+	void close() {file.close();}
+	bool atEnd() const {return file.atEnd();}
+	bool next(quint64 &timestamp, QByteArray &data);
+	void rewind();
+private:
+	QFile file;
+};
+
+#endif // RDACCAPTURE_H
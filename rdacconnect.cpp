@@ -20,49 +20,42 @@
 
 #include "rdacconnect.h"
 
-RDACmessage1::RDACmessage1() : flow1(0)
-  , pulseRatio1(0)
-  , flow2(0)
-  , pulseRatio2(0)
-  , oilTemp(0)
-  , oilPress(0)
-  , aux1(0)
-  , aux2(0)
-  , fuelPress(0)
-  , coolant(0)
-  , fuelLevel1(0)
-  , fuelLevel2(0)
-  , rpm1(0)
-  , rpm2(0)
-  , internalTemp(0)
-  , volts(0)
+RDACconnect::RDACconnect(QObject *parent) : QObject(parent)
+  , lastRateUpdate(0)
+  , lastStatsLog(0)
+  , settings("settings/settings.ini", QSettings::IniFormat, parent)
+  , replay(0)
+  , probe(0)
+  , probeAttempts(0)
 {
-}
+    for(int i = 0; i < RDACmessageTypeCount; ++i)
+    {
+        lastMessageReception[i] = -1;
+        framesAtLastRateUpdate[i] = 0;
+    }
 
-RDACmessage2::RDACmessage2() : oilTemperature(0)
-  , oilPressure(0)
-  , fuelLevel1(0)
-  , fuelLevel2(0)
-  , voltage(0)
-  , internalTemperature(0)
-  , cht1(0)
-  , cht2(0)
-  , manifoldPressure(0)
-{
-}
+    // Message 2 reports oil pressure and voltage as raw readings
+    message2OilPressure = CalibrationCurve::polynomial(QVector<qreal>() << -31.2628022226 << 0.3320318366, 0.0, 65535.0);
+    message2OilPressure.load(settings, "rdacMessage2OilPressure");
+    message2Voltage = CalibrationCurve::polynomial(QVector<qreal>() << 115.0 * 0.0069693802 << 0.0069693802, 0.0, 65535.0);
+    message2Voltage.load(settings, "rdacMessage2Voltage");
 
-RDACmessage3::RDACmessage3() : timeBetweenPulses(0)
-{
-}
+    // Log the link statistics every n seconds, 0 disables logging
+    statsLogInterval = settings.value("Logging/rdacStatsInterval", 60).toInt();
+    statsTimer = new QTimer(this);
+    connect(statsTimer, SIGNAL(timeout()), this, SLOT(updateLinkStats()));
 
-RDACmessage4::RDACmessage4()
-{
+    serial = 0;
+    attachSerialPort(new QSerialPort(this));
 }
 
-RDACconnect::RDACconnect(QObject *parent) : QObject(parent)
-  , settings("./settings.ini", QSettings::IniFormat, parent)
+/*! \brief Makes port the serial port the RDAC is read from
+*/
+void RDACconnect::attachSerialPort(QSerialPort *port)
 {
-    serial = new QSerialPort(this);
+    delete serial;
+    serial = port;
+    serial->setParent(this);
 
     connect(serial, SIGNAL(error(QSerialPort::SerialPortError)), this,
                 SLOT(handleError(QSerialPort::SerialPortError)));
@@ -71,266 +64,237 @@ RDACconnect::RDACconnect(QObject *parent) : QObject(parent)
     connect(serial, SIGNAL(readyRead()), this, SLOT(readData()));
 }
 
+/*! \brief Drains everything the serial port has buffered
+*
+* Every chunk is recorded into the capture file, if one is open, before it is parsed.
+*/
 void RDACconnect::readData()
 {
-	bool startPatternFound = false;
-
-    data.append(serial->read(1));
-
-//            emit userMessage("RDAC COM error", "Error reading data, closing application", true);
-//            exec();
-//        }
-
-    if(searchStart(&data))
-    {
-        startPatternFound = true;
-        quint8 messageType = 0x00;
-        switch(checkPatternValidity(&data, messageType))
-        {
-        case rdacResultMessageComplete:
-            emit statusMessage("Everything OK - Last update: " + lastMessageReception.value(3).toString("hh:mm:ss.zzz"), Qt::white);
-            switch(messageType)
-            {
-                case 0x01:
-                    handleMessage1(&data);
-                    break;
-                case 0x02:
-                    handleMessage2(&data);
-                    break;
-                case 0x03:
-                    handleMessage3(&data);
-                    break;
-                case 0x04:
-                    handleMessage4(&data);
-                    break;
-                default:
-                    data.remove(0, 1);
-                    break;
-            }
-            break;
-        case rdacResultMessageIncomplete:
-            break;
-        default:
-            emit statusMessage("Found pattern not valid", Qt::yellow);
-            break;
-        }
-    }
-    if(!startPatternFound)
-    {
-        emit statusMessage("No start pattern found yet", Qt::red);
-    }
+	char chunk[256];
+	forever
+	{
+		const qint64 length = serial->read(chunk, sizeof(chunk));
+		if(length <= 0)
+		{
+			break;
+		}
+		if(capture.isOpen())
+		{
+			capture.write(linkClock.nsecsElapsed(), chunk, int(length));
+		}
+		ingest(chunk, int(length));
+	}
 }
 
-quint8 RDACconnect::calculateChecksum1(QByteArray data)
+void RDACconnect::replayData(const QByteArray &data)
 {
-    quint8 checksum = 0x55;
-    qDebug() << checksum;
-    for(int i = 2; i < data.size()-2; ++i)
-	{
-        checksum += quint8(data.at(i));
-	}
-	return checksum;
+	ingest(data.constData(), data.size());
 }
 
-quint8 RDACconnect::calculateChecksum2(QByteArray data)
+/*! \brief Feeds received bytes through the parser
+*
+* Every complete frame is decoded before more bytes are appended, so the ring buffer can
+* never overflow.
+*/
+void RDACconnect::ingest(const char *data, int length)
 {
-    quint8 checksum = 0xAA;
-    for(int i = 2; i < data.size()-2; ++i)
+	while(length > 0)
 	{
-        checksum += quint8(data.at(i));
+		const int accepted = parser.append(data, length);
+		processFrames();
+		data += accepted;
+		length -= accepted;
 	}
-	return checksum;
 }
 
-bool RDACconnect::searchStart(QByteArray *data)
+void RDACconnect::processFrames()
 {
-	while(data->size() >= 3)
-    {
-        if(data->at(0) == 0x05)
-        {
-            if(data->at(1) == 0x02)
+	RDACframe frame;
+	RDACparser::rdacResults result;
+	while((result = parser.nextFrame(frame)) != RDACparser::rdacResultMessageIncomplete)
+	{
+		switch(result)
+		{
+		case RDACparser::rdacResultMessageComplete:
+			noteReception(frame.type);
+			if(!statusOk)
 			{
-                if((data->at(2) == 0x01))
-                {
-                    //numTries += 1;
-					return true;
-				}
+				emit statusMessage("Everything OK", Qt::white);
+				statusOk = true;
 			}
+			switch(frame.type)
+			{
+				case 0x01:
+					handleMessage1(frame);
+					break;
+				case 0x02:
+					handleMessage2(frame);
+					break;
+				case 0x03:
+					handleMessage3(frame);
+					break;
+				case 0x04:
+					handleMessage4(frame);
+					break;
+			}
+			break;
+		default:
+			emit statusMessage("Found pattern not valid", Qt::yellow);
+			statusOk = false;
+			break;
 		}
-		data->remove(0, 1);
 	}
-	return false;
 }
 
-RDACconnect::rdacResults RDACconnect::checkPatternValidity(QByteArray *data, quint8 &messageType)
+/*! \brief Records the arrival of a frame and tracks the longest gap per message type
+*/
+void RDACconnect::noteReception(quint8 messageType)
 {
-	// Determine and check neccessary size of data
-	quint8 requiredSize = 0;
-    messageType = data->at(2);
-	switch(messageType)
+	const qint64 now = linkClock.elapsed();
+	qint64 &last = lastMessageReception[messageType - 1];
+	if(last >= 0)
 	{
-		case 0x01:
-            requiredSize = 66;
-			break;
-		case 0x02:
-			requiredSize = 23;
-			break;
-		case 0x03:
-			requiredSize = 7;
-			break;
-		case 0x04:
-			requiredSize = 29;
-			break;
-		default:
-			data->remove(0, 1);
-			return rdacResultMessageIllegalDatatype;
+		RDAClinkStats::raise(parser.stats().maxFrameGap[messageType - 1], quint32(now - last));
 	}
-	if(data->size() < requiredSize)
+	last = now;
+}
+
+/*! \brief Calculates the frame rates once per second and periodically logs the counters
+*/
+void RDACconnect::updateLinkStats()
+{
+	RDAClinkStats &stats = parser.stats();
+	const qint64 now = linkClock.elapsed();
+	const qint64 elapsed = now - lastRateUpdate;
+	if(elapsed <= 0)
 	{
-		return rdacResultMessageIncomplete;
+		return;
 	}
 
-	// Calculate and check checksums
-    if(quint8(data->at(requiredSize - 2)) == calculateChecksum1(data->mid(0, requiredSize)))
+	for(int i = 0; i < RDACmessageTypeCount; ++i)
 	{
-        if(quint8(data->at(requiredSize - 1)) == calculateChecksum2(data->mid(0, requiredSize)))
-		{
-            //numSuccess += 1;
-            //qDebug() << "Sucesses:" << numSuccess << "; Tries:" << numTries << "; " << numSuccess/numTries << "%";
-			return rdacResultMessageComplete;
-		}
-		else
-		{
-			qWarning() << "Checksum 2 incorrect" << quint8(data->at(requiredSize - 1));
-			data->remove(0, 1);
-			return rdacResultMessageInvalidChecksum2;
-		}
+		const quint32 frames = stats.frames[i].load();
+		stats.framesPerSecond[i].store(quint32((frames - framesAtLastRateUpdate[i]) * 100000ull / elapsed));
+		framesAtLastRateUpdate[i] = frames;
 	}
-	else
+	lastRateUpdate = now;
+
+	if(statsLogInterval > 0 && now - lastStatsLog >= statsLogInterval * 1000)
 	{
-		qWarning() << "Checksum 1 incorrect" << quint8(data->at(requiredSize - 2));
-		data->remove(0, 1);
-		return rdacResultMessageInvalidChecksum1;
+		qInfo() << "RDAC link:" << stats.summary();
+		lastStatsLog = now;
 	}
 }
 
-void RDACconnect::handleMessage1(QByteArray *data)
+void RDACconnect::handleMessage1(const RDACframe &frame)
 {
-	lastMessageReception.insert(1, QDateTime::currentDateTimeUtc());
 //    QFile file("/home/rstory/datapacket.log");
 //    file.open(QIODevice::WriteOnly);
 //    file.write(data->toHex());
 //    file.close();
-	RDACmessage1 message;
-    memcpy(&message, data->mid(4, 62).constData(), 62);
-
-    if (message.pulseRatio1 == 65535) {
-        message.pulseRatio1 = 0;
-    }
-
-    if (message.pulseRatio2 == 65535) {
-        message.pulseRatio2 = 0;
-    }
-
-    //qDebug() << Q_FUNC_INFO << "Pulses" << message.flow1;
-
-    volts = round(message.volts/5.73758)*0.1;
 
     lastMessage1 = QDateTime::currentDateTimeUtc();
 
-    qreal oilPressVolt = message.oilPress / (4096/5);
-
-    qreal fuelflow = (message.flow1 / 4) * 60.0 * 60.0; // This converts the pulse data from the RDAC (# of pulses per 4 second period) into pulses/hour
-    emit rdacUpdateMessage(fuelflow, volts);
+    RDACsample sample;
+    sample.timestamp = lastMessage1.toMSecsSinceEpoch();
+    memcpy(sample.value, frame.value, sizeof(sample.value));
+    if(!samples.push(sample))
+    {
+        RDAClinkStats::add(parser.stats().samplesDropped);
+    }
 }
 
-void RDACconnect::handleMessage2(QByteArray *data)
+void RDACconnect::handleMessage2(const RDACframe &frame)
 {
-	lastMessageReception.insert(2, QDateTime::currentDateTimeUtc());
-	RDACmessage2 message;
-	memcpy(&message, data->mid(3, 18).constData(), 18);
-	data->remove(0, 23);
-
-	double voltage = (static_cast<double>(message.voltage) + 115.0) * 0.0069693802;
-	double oilPressure = 0.3320318366 * message.oilPressure - 31.2628022226;
+	qreal oilPressure = 0.0;
+	qreal voltage = 0.0;
+	message2OilPressure.convert(frame.value[RDACm2OilPressure], oilPressure);
+	message2Voltage.convert(frame.value[RDACm2Voltage], voltage);
 	if(oilPressure < 0.0)
 	{
 		oilPressure = 0.0;
 	}
 
-	qreal insideAirTemperature = qreal(message.internalTemperature) / 100.0;
-	qreal outsideAirTemperature = qreal(message.cht1) / 100.0;
-
-	emit updateDataMessage2(insideAirTemperature, outsideAirTemperature, message.cht2, message.oilTemperature, oilPressure, voltage, message.manifoldPressure);
+	emit updateDataMessage2(frame.value[RDACm2InternalTemperature], frame.value[RDACm2Cht1], frame.value[RDACm2Cht2], frame.value[RDACm2OilTemperature], oilPressure, voltage, frame.value[RDACm2ManifoldPressure]);
 }
 
-void RDACconnect::handleMessage3(QByteArray *data)
+void RDACconnect::handleMessage3(const RDACframe &frame)
 {
-	lastMessageReception.insert(3, QDateTime::currentDateTimeUtc());
-	RDACmessage3 message;
-	memcpy(&message, data->mid(3, 2).constData(), 2);
-	data->remove(0, 7);
-
+	const qreal timeBetweenPulses = frame.value[RDACm3TimeBetweenPulses];
 	double revFudge = (6000.0 / 19.6) * 15586.0;
-	double rpm = revFudge / message.timeBetweenPulses;
-	if(message.timeBetweenPulses > 30000)
+	double rpm = 0.0;
+	if(timeBetweenPulses > 0.0 && timeBetweenPulses <= 30000.0)
 	{
-		rpm = 0.0;
+		rpm = revFudge / timeBetweenPulses;
 	}
 
 	emit updateDataMessage3(rpm);
-	qDebug() << Q_FUNC_INFO << rpm;
 }
 
-void RDACconnect::handleMessage4(QByteArray *data)
+void RDACconnect::handleMessage4(const RDACframe &frame)
 {
-	lastMessageReception.insert(4, QDateTime::currentDateTimeUtc());
-	RDACmessage4 message;
-	memcpy(&message, data->mid(3, 24).constData(), 24);
-
-	data->remove(0, 29);
-
-	emit updateDataMessage4egt(message.thermocouple[0], message.thermocouple[1], message.thermocouple[2], message.thermocouple[3]);
-	emit updateDataMessage4cht(message.thermocouple[4], message.thermocouple[5], message.thermocouple[6], message.thermocouple[7]);
+	const qreal *thermocouple = frame.value + RDACm4Thermocouple1;
+	emit updateDataMessage4egt(thermocouple[0], thermocouple[1], thermocouple[2], thermocouple[3]);
+	emit updateDataMessage4cht(thermocouple[4], thermocouple[5], thermocouple[6], thermocouple[7]);
 }
 
 void RDACconnect::openSerialPort()
 {
-    QSerialPortInfo portToUse;
-    foreach (const QSerialPortInfo &info, QSerialPortInfo::availablePorts())
+    // Runs in the RDAC thread, so the statistics timer has to be started here
+    linkClock.start();
+    statsTimer->start(1000);
+
+    // A capture replay replaces the serial port completely
+    if(startReplay())
     {
-        QString s = QObject::tr("Port:") + info.portName() + "\n"
-                    + QObject::tr("Location:") + info.systemLocation() + "\n"
-                    + QObject::tr("Description:") + info.description() + "\n"
-                    + QObject::tr("Manufacturer:") + info.manufacturer() + "\n"
-                    + QObject::tr("Serial number:") + info.serialNumber() + "\n"
-                    + QObject::tr("Vendor Identifier:") + (info.hasVendorIdentifier() ? QString::number(info.vendorIdentifier(), 16) : QString()) + "\n"
-                    + QObject::tr("Product Identifier:") + (info.hasProductIdentifier() ? QString::number(info.productIdentifier(), 16) : QString()) + "\n"
-                    + QObject::tr("Busy:") + (info.isBusy() ? QObject::tr("Yes") : QObject::tr("No")) + "\n";
-
-        if(!info.isBusy() && (info.description().contains("Arduino") || info.manufacturer().contains("Arduino")))
-            portToUse = info;
-        qDebug() << s;
+        return;
     }
 
-    if(portToUse.isNull() || !portToUse.isValid())
+    // RDAC/port is either "arduino", "auto" or the name of the port to use
+    const QString portSetting = settings.value("RDAC/port", "arduino").toString();
+    if(portSetting == "auto")
     {
-        qDebug() << "port is not valid:" << portToUse.portName();
+        startProbe();
         return;
     }
 
-    // Enumerate the serial port
-    // Find one that sounds like Arduino, or the highest one on the list
-    // Open it if it isn't busy
+    QString portName = portSetting;
+    if(portSetting == "arduino")
+    {
+        QSerialPortInfo portToUse;
+        foreach (const QSerialPortInfo &info, QSerialPortInfo::availablePorts())
+        {
+            QString s = QObject::tr("Port:") + info.portName() + "\n"
+                        + QObject::tr("Location:") + info.systemLocation() + "\n"
+                        + QObject::tr("Description:") + info.description() + "\n"
+                        + QObject::tr("Manufacturer:") + info.manufacturer() + "\n"
+                        + QObject::tr("Serial number:") + info.serialNumber() + "\n"
+                        + QObject::tr("Vendor Identifier:") + (info.hasVendorIdentifier() ? QString::number(info.vendorIdentifier(), 16) : QString()) + "\n"
+                        + QObject::tr("Product Identifier:") + (info.hasProductIdentifier() ? QString::number(info.productIdentifier(), 16) : QString()) + "\n"
+                        + QObject::tr("Busy:") + (info.isBusy() ? QObject::tr("Yes") : QObject::tr("No")) + "\n";
+
+            if(!info.isBusy() && (info.description().contains("Arduino") || info.manufacturer().contains("Arduino")))
+                portToUse = info;
+            qDebug() << s;
+        }
 
-    serial->setPortName(portToUse.portName());
+        if(portToUse.isNull() || !portToUse.isValid())
+        {
+            qDebug() << "port is not valid:" << portToUse.portName();
+            return;
+        }
+        portName = portToUse.portName();
+    }
+
+    serial->setPortName(portName);
     serial->setBaudRate(QSerialPort::Baud38400);
     serial->setDataBits(QSerialPort::Data8);
     serial->setParity(QSerialPort::NoParity);
     serial->setStopBits(QSerialPort::OneStop);
     serial->setFlowControl(QSerialPort::NoFlowControl);
     if (serial->open(QIODevice::ReadWrite)) {
-        qDebug() << "Connected to" << portToUse.description() << "on" << portToUse.portName();
+        qDebug() << "Connected to" << serial->portName();
+        startCapture();
     } else {
         qCritical() << "Serial Port error:" << serial->errorString();
 
@@ -340,8 +304,98 @@ void RDACconnect::openSerialPort()
 
 
 
+/*! \brief Opens all free ports at once and binds to the first one that sends valid frames
+*
+* Only used with RDAC/port=auto. RDAC/probePorts lists additional device paths, e.g.
+* pseudo-terminals, and RDAC/probeExclude ports that must not be touched; the Sky Map NMEA port
+* is always excluded. RDAC/probeTimeout is how long to listen in milliseconds.
+*/
+void RDACconnect::startProbe()
+{
+    if(!probe)
+    {
+        probe = new RDACprobe(this);
+        connect(probe, SIGNAL(portFound(QSerialPort*)), this, SLOT(probeSucceeded(QSerialPort*)));
+        connect(probe, SIGNAL(probeFailed()), this, SLOT(retryProbe()));
+    }
+
+    QStringList excludedPorts = settings.value("RDAC/probeExclude").toStringList();
+    // NMEAconnect reads its port from its own settings file
+    excludedPorts << QSettings("./settings.ini", QSettings::IniFormat).value("SkyMap/Port", "COM4").toString();
+    excludedPorts.removeAll(QString());
+
+    ++probeAttempts;
+    probe->start(settings.value("RDAC/probePorts").toStringList(), excludedPorts, settings.value("RDAC/probeTimeout", 1500).toInt());
+}
+
+/*! \brief Probes again after a failed probe, waiting twice as long each time
+*
+* Gives up after RDAC/probeAttempts probes (default 5), 0 keeps probing. The wait between two
+* probes starts at RDAC/probeTimeout and is capped at one minute.
+*/
+void RDACconnect::retryProbe()
+{
+    const int maxAttempts = settings.value("RDAC/probeAttempts", 5).toInt();
+    if(maxAttempts > 0 && probeAttempts >= maxAttempts)
+    {
+        qWarning() << "No RDAC found after" << probeAttempts << "probes, giving up";
+        emit statusMessage("No RDAC found", Qt::red);
+        return;
+    }
+
+    const int timeout = settings.value("RDAC/probeTimeout", 1500).toInt();
+    const int delay = int(qMin(qint64(60000), qint64(timeout) << qMin(probeAttempts - 1, 16)));
+    QTimer::singleShot(delay, this, SLOT(startProbe()));
+}
+
+void RDACconnect::probeSucceeded(QSerialPort *port)
+{
+    attachSerialPort(port);
+    startCapture();
+    readData();
+}
+
+void RDACconnect::startCapture()
+{
+    if(settings.value("RDAC/capture", false).toBool() && !capture.isOpen())
+    {
+        capture.open(QString("RDACcapture ").append(QDateTime::currentDateTimeUtc().toString("yyyy-MM-dd hh.mm.ss")).append(".rdac"));
+    }
+}
+
+/*! \brief Starts replaying RDAC/replayFile if it is set
+*
+* RDAC/replaySpeed selects real time (1), N times faster (N) or as fast as possible (0). The
+* replay waits for the GUI to drain the sample queue, so no sample is dropped at any speed.
+*/
+bool RDACconnect::startReplay()
+{
+    const QString replayFile = settings.value("RDAC/replayFile").toString();
+    if(replayFile.isEmpty())
+    {
+        return false;
+    }
+
+    replay = new RDACreplay(this);
+    connect(replay, SIGNAL(bytesReplayed(QByteArray)), this, SLOT(replayData(QByteArray)));
+
+    // Hold the replay back while the sample queue could overflow. A capture record is at most
+    // 256 bytes, together with a partial frame left over that completes at most 5 message 1 frames.
+    replay->setReadyCheck([this]() { return samples.size() <= RDACsampleQueue::capacity() - 5; });
+    return replay->start(replayFile, settings.value("RDAC/replaySpeed", 1.0).toDouble(), settings.value("RDAC/replayLoop", false).toBool());
+}
+
+/*! \brief Closes the port, the capture file and any ports still being probed
+*
+* Runs in the RDAC thread, main() calls it there before the thread is stopped.
+*/
 void RDACconnect::closeSerialPort()
 {
+    if(probe)
+    {
+        probe->stop();
+    }
+    capture.close();
     serial->close();
     qDebug() << tr("Disconnected");
 }
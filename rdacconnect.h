@@ -25,97 +25,70 @@
 #include <QtGui/QColor>
 #include <QtSerialPort/QSerialPort>
 #include <QtSerialPort/QSerialPortInfo>
+#include "rdacparser.h"
+#include "spscqueue.h"
+#include "rdaccapture.h"
+#include "rdacreplay.h"
+#include "rdacprobe.h"
+#include "calibration.h"
 
-//! RDAC Connect Class
+//! RDAC Sample
 /*!
- * This class interprets the messages coming from the MGL RDAC.
+ * The decoded fields of one RDAC message 1, handed from the serial thread to the GUI thread.
 */
 
-#pragma pack(1)
-struct RDACmessage1
+struct RDACsample
 {
-public:
-	RDACmessage1();
-    quint16 flow1;
-    quint16 pulseRatio1;
-    quint16 flow2;
-    quint16 pulseRatio2;
-    quint16 thermocouple[12];
-    quint16 oilTemp;
-    quint16 oilPress;
-    quint16 aux1;
-    quint16 aux2;
-    quint16 fuelPress;
-    quint16 coolant;
-    quint16 fuelLevel1;
-    quint16 fuelLevel2;
-    quint16 rpm1;
-    quint16 rpm2;
-    quint16 map;
-    quint16 current;
-    quint16 internalTemp;
-    quint16 volts;
+	qint64 timestamp; // Milliseconds since epoch, UTC
+	qreal value[RDACm1FieldCount];
 };
 
-struct RDACmessage2
-{
-public:
-	RDACmessage2();
-	quint16 oilTemperature;
-	quint16 oilPressure;
-	quint16 fuelLevel1;
-	quint16 fuelLevel2;
-	quint16 voltage;
-	quint16 internalTemperature;
-	quint16 cht1;
-	quint16 cht2;
-	quint16 manifoldPressure;
-};
+typedef SpscQueue<RDACsample, 64> RDACsampleQueue;
 
-struct RDACmessage3
-{
-public:
-	RDACmessage3();
-	quint16 timeBetweenPulses;
-};
-
-struct RDACmessage4
-{
-public:
-	RDACmessage4();
-	quint16 thermocouple[12];
-};
-#pragma pack()
+//! RDAC Connect Class
+/*!
+ * This class interprets the messages coming from the MGL RDAC. It is meant to live in its own
+ * thread, so serial reading, framing and decoding never wait for the GUI. Message 1 samples are
+ * passed on through sampleQueue(), which the GUI thread drains once per display frame.
+*/
 
 class RDACconnect : public QObject
 {
 	Q_OBJECT
 public:
     RDACconnect(QObject *parent = 0);
-	static quint8 calculateChecksum1(QByteArray data);
-	static quint8 calculateChecksum2(QByteArray data);
-	enum rdacResults {
-		rdacResultMessageComplete,
-		rdacResultMessageIncomplete,
-		rdacResultMessageInvalidChecksum1,
-		rdacResultMessageInvalidChecksum2,
-		rdacResultMessageIllegalDatatype
-	};
+    RDACsampleQueue *sampleQueue() {return &samples;}
+    const RDAClinkStats &linkStats() const {return parser.stats();}
 private:
-	bool searchStart(QByteArray *data);
-	rdacResults checkPatternValidity(QByteArray *data, quint8 &messageType);
-	QMap<quint8, QDateTime> lastMessageReception;
+	void ingest(const char *data, int length);
+	void processFrames();
+	bool startReplay();
+	void attachSerialPort(QSerialPort *port);
+	void startCapture();
+	void noteReception(quint8 messageType);
+	QElapsedTimer linkClock;
+	qint64 lastMessageReception[RDACmessageTypeCount];
+	quint32 framesAtLastRateUpdate[RDACmessageTypeCount];
+	qint64 lastRateUpdate;
+	qint64 lastStatsLog;
+	int statsLogInterval;
+	QTimer *statsTimer;
 	QDateTime lastMessage1;
-	void handleMessage1(QByteArray *data);
-	void handleMessage2(QByteArray *data);
-	void handleMessage3(QByteArray *data);
-	void handleMessage4(QByteArray *data);
+	void handleMessage1(const RDACframe &frame);
+	void handleMessage2(const RDACframe &frame);
+	void handleMessage3(const RDACframe &frame);
+	void handleMessage4(const RDACframe &frame);
 	QSettings settings;
     QSerialPort *serial;
-    QByteArray data;
-    float numTries = 0.0;
-    float numSuccess = 0.0;
-    qreal volts;
+    RDACparser parser;
+    RDACsampleQueue samples;
+    RDACcaptureWriter capture;
+    RDACreplay *replay;
+    RDACprobe *probe;
+    int probeAttempts;
+    CalibrationCurve message2OilPressure;
+    CalibrationCurve message2Voltage;
+    bool statusOk = false;
 
 public slots:
     void openSerialPort();
@@ -125,6 +98,11 @@ private slots:
     void writeData(const QByteArray &data);
     void readData();
     void handleError(QSerialPort::SerialPortError error);
+    void updateLinkStats();
+    void replayData(const QByteArray &data);
+    void startProbe();
+    void retryProbe();
+    void probeSucceeded(QSerialPort *port);
 
 signals:
 	void updateDataMessage1(double fuelFlowValue, double fuelAbsoluteValue);
@@ -134,7 +112,6 @@ signals:
 	void updateDataMessage4cht(quint16 cht1, quint16 cht2, quint16 cht3, quint16 cht4);
 	void userMessage(QString title, QString content, bool endApplication);
 	void statusMessage(QString text, QColor color);
-    void rdacUpdateMessage(qreal fuelFlow, qreal volts);
 };
 
 #endif // RDACCONNECT_H
@@ -0,0 +1,43 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "rdaclinkstats.h"
+
+/*! \brief Formats all counters into a single line for the log
+*/
+QString RDAClinkStats::summary() const
+{
+	QString text = QString("bytes %1, discarded %2, checksum1 errors %3, checksum2 errors %4, dropped samples %5")
+			.arg(bytesReceived.load())
+			.arg(bytesDiscarded.load())
+			.arg(checksum1Failures.load())
+			.arg(checksum2Failures.load())
+			.arg(samplesDropped.load());
+
+	for(int i = 0; i < RDACmessageTypeCount; ++i)
+	{
+		text.append(QString("; type %1: %2 frames, %3/s, max gap %4 ms")
+					.arg(i + 1)
+					.arg(frames[i].load())
+					.arg(framesPerSecond[i].load() / 100.0, 0, 'f', 2)
+					.arg(maxFrameGap[i].load()));
+	}
+	return text;
+}
@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef RDACLINKSTATS_H
+#define RDACLINKSTATS_H
+
+#include <QtCore>
+#include "rdacprotocol.h"
+
+//! RDAC Link Statistics
+/*!
+ * Counters describing the quality of the RDAC serial link. They are only ever written by the
+ * thread that parses the stream, so increments are plain relaxed load/store pairs instead of
+ * atomic read-modify-write operations. Any other thread can read them at any time without
+ * taking a lock.
+*/
+
+struct RDAClinkStats
+{
+	typedef QAtomicInteger<quint32> Counter;
+
+	Counter bytesReceived;
+	Counter bytesDiscarded; // Dropped while searching for a start pattern
+	Counter checksum1Failures;
+	Counter checksum2Failures;
+	Counter samplesDropped; // GUI did not drain the sample queue in time
+	Counter frames[RDACmessageTypeCount];
+	Counter framesPerSecond[RDACmessageTypeCount]; // In hundredths of a frame per second
+	Counter maxFrameGap[RDACmessageTypeCount]; // Longest time between two frames in ms
+
+	static void add(Counter &counter, quint32 amount = 1) {counter.store(counter.load() + amount);}
+	static void raise(Counter &counter, quint32 value) {if(value > counter.load()) counter.store(value);}
+
+	QString summary() const;
+};
+
+#endif // RDACLINKSTATS_H
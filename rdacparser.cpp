@@ -0,0 +1,164 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2012 Tobias Rad                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "rdacparser.h"
+
+RDACparser::RDACparser() : head(0)
+  , count(0)
+{
+}
+
+/*! \brief Copies received bytes into the ring buffer
+*
+* Returns the number of bytes accepted, which is less than length if the buffer is full.
+* Complete frames should be taken out with nextFrame() before appending the rest.
+*/
+int RDACparser::append(const char *data, int length)
+{
+	length = qMin(length, freeSpace());
+	int tail = (head + count) & (bufferCapacity - 1);
+	for(int i = 0; i < length; ++i)
+	{
+		buffer[tail] = quint8(data[i]);
+		tail = (tail + 1) & (bufferCapacity - 1);
+	}
+	count += length;
+	RDAClinkStats::add(linkStats.bytesReceived, length);
+	return length;
+}
+
+void RDACparser::clear()
+{
+	head = 0;
+	count = 0;
+}
+
+void RDACparser::skip(int length)
+{
+	head = (head + length) & (bufferCapacity - 1);
+	count -= length;
+}
+
+quint8 RDACparser::sumBytes(const quint8 *data, int length)
+{
+	quint8 sum = 0;
+	for(int i = 0; i < length; ++i)
+	{
+		sum += data[i];
+	}
+	return sum;
+}
+
+/*! \brief Checks both checksums of the frame at the read cursor in place
+*
+* Checksum 1 and 2 are the same byte sum over everything between the sync and the checksums,
+* seeded with 0x55 and 0xAA respectively, so a single pass over the ring buffer (at most two
+* contiguous spans) verifies both without copying the frame.
+*/
+RDACparser::rdacResults RDACparser::verifyChecksums(int frameSize) const
+{
+	const int start = (head + 2) & (bufferCapacity - 1);
+	const int length = frameSize - 4;
+	const int firstSpan = qMin(length, int(bufferCapacity) - start);
+	const quint8 sum = sumBytes(buffer + start, firstSpan) + sumBytes(buffer, length - firstSpan);
+
+	if(at(frameSize - 2) != quint8(sum + 0x55))
+	{
+		return rdacResultMessageInvalidChecksum1;
+	}
+	if(at(frameSize - 1) != quint8(sum + 0xAA))
+	{
+		return rdacResultMessageInvalidChecksum2;
+	}
+	return rdacResultMessageComplete;
+}
+
+/*! \brief Advances the read cursor to the next start pattern
+*
+* A start pattern is the sync followed by a message type that has a descriptor. Bytes in
+* front of the pattern are dropped by moving the cursor only. Returns false if fewer than
+* three bytes are left to look at.
+*/
+bool RDACparser::searchStart()
+{
+	while(count >= 3)
+	{
+		if(at(0) == 0x05 && at(1) == 0x02 && rdacDescriptor(at(2)))
+		{
+			return true;
+		}
+		skip(1);
+		RDAClinkStats::add(linkStats.bytesDiscarded);
+	}
+	return false;
+}
+
+/*! \brief Extracts and scales every field listed in the frame's descriptor
+*/
+void RDACparser::decodeFields(RDACframe &frame)
+{
+	rdacDecodeFields(*frame.descriptor, frame.bytes + frame.descriptor->payloadOffset, frame.value);
+}
+
+/*! \brief Takes the next frame out of the ring buffer
+*
+* The checksums are verified in the ring buffer first, so only valid frames are copied. On
+* rdacResultMessageComplete the frame has been copied into frame, its fields have been
+* decoded and the cursor has been advanced past it. Any other result except
+* rdacResultMessageIncomplete means the candidate at the cursor was rejected and skipped, so
+* the caller should simply call again until the buffer reports an incomplete message.
+*/
+RDACparser::rdacResults RDACparser::nextFrame(RDACframe &frame)
+{
+	if(!searchStart())
+	{
+		return rdacResultMessageIncomplete;
+	}
+
+	// Determine and check neccessary size of data
+	const RDACmessageDescriptor *descriptor = rdacDescriptor(at(2));
+	const int frameSize = descriptor->length;
+	if(count < frameSize)
+	{
+		return rdacResultMessageIncomplete;
+	}
+
+	// Calculate and check checksums
+	const rdacResults result = verifyChecksums(frameSize);
+	if(result != rdacResultMessageComplete)
+	{
+		RDAClinkStats::add(result == rdacResultMessageInvalidChecksum1 ? linkStats.checksum1Failures : linkStats.checksum2Failures);
+		RDAClinkStats::add(linkStats.bytesDiscarded);
+		skip(1);
+		return result;
+	}
+
+	frame.type = descriptor->type;
+	frame.size = frameSize;
+	frame.descriptor = descriptor;
+	for(int i = 0; i < frameSize; ++i)
+	{
+		frame.bytes[i] = at(i);
+	}
+	decodeFields(frame);
+	RDAClinkStats::add(linkStats.frames[frame.type - 1]);
+	skip(frameSize);
+	return rdacResultMessageComplete;
+}
@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2012 Tobias Rad                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef RDACPARSER_H
+#define RDACPARSER_H
+
+#include <QtCore>
+#include "rdacprotocol.h"
+#include "rdaclinkstats.h"
+
+//! RDAC Frame
+/*!
+ * A single, complete message copied out of the parser's ring buffer together with its
+ * field values, already scaled according to the message descriptor.
+*/
+
+struct RDACframe
+{
+	RDACframe() : type(0), size(0), descriptor(Q_NULLPTR) {}
+	quint8 type;
+	int size;
+	const RDACmessageDescriptor *descriptor;
+	quint8 bytes[RDACmaxFrameLength];
+	qreal value[RDACmaxFieldCount];
+};
+
+//! RDAC Parser Class
+/*!
+ * This class frames the byte stream coming from the MGL RDAC. Received bytes are kept in a
+ * fixed-capacity ring buffer which is scanned for the 0x05 0x02 sync with a read cursor, so
+ * resyncing after line noise never moves memory. Every frame is consumed exactly once.
+*/
+
+class RDACparser
+{
+public:
+	RDACparser();
+	enum {
+		bufferCapacity = 1024 // Must be a power of two
+	};
+	enum rdacResults {
+		rdacResultMessageComplete,
+		rdacResultMessageIncomplete,
+		rdacResultMessageInvalidChecksum1,
+		rdacResultMessageInvalidChecksum2,
+		rdacResultMessageIllegalDatatype
+	};
+	int append(const char *data, int length);
+	rdacResults nextFrame(RDACframe &frame);
+	int size() const {return count;}
+	int freeSpace() const {return bufferCapacity - count;}
+	void clear();
+	RDAClinkStats &stats() {return linkStats;}
+	const RDAClinkStats &stats() const {return linkStats;}
+private:
+	quint8 at(int index) const {return buffer[(head + index) & (bufferCapacity - 1)];}
+	void skip(int length);
+	bool searchStart();
+	rdacResults verifyChecksums(int frameSize) const;
+	static quint8 sumBytes(const quint8 *data, int length);
+	static void decodeFields(RDACframe &frame);
+	quint8 buffer[bufferCapacity];
+	int head;
+	int count;
+	RDAClinkStats linkStats;
+};
+
+#endif // RDACPARSER_H
@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "rdacprobe.h"
+
+RDACprobe::RDACprobe(QObject *parent) : QObject(parent)
+{
+	timeoutTimer.setSingleShot(true);
+	connect(&timeoutTimer, SIGNAL(timeout()), this, SLOT(probeTimedOut()));
+}
+
+RDACprobe::~RDACprobe()
+{
+	stop();
+}
+
+/*! \brief Opens every free port that is not excluded plus the extra device paths and starts sniffing
+*
+* Opening a port toggles DTR, which resets Arduino-class adapters, so excludedPorts should list
+* every port another component uses. Emits portFound() as soon as one port delivers a valid frame, or probeFailed() if none did
+* within timeout milliseconds.
+*/
+void RDACprobe::start(const QStringList &extraPorts, const QStringList &excludedPorts, int timeout)
+{
+	stop();
+
+	foreach(const QSerialPortInfo &info, QSerialPortInfo::availablePorts())
+	{
+		if(!info.isBusy() && !excludedPorts.contains(info.portName()) && !excludedPorts.contains(info.systemLocation()))
+		{
+			addCandidate(info.systemLocation());
+		}
+	}
+	foreach(const QString &portName, extraPorts)
+	{
+		addCandidate(portName);
+	}
+
+	qDebug() << "Probing" << candidates.size() << "serial ports for the RDAC";
+	timeoutTimer.start(timeout);
+}
+
+void RDACprobe::stop()
+{
+	timeoutTimer.stop();
+	foreach(Candidate *candidate, candidates)
+	{
+		delete candidate->port;
+		delete candidate;
+	}
+	candidates.clear();
+}
+
+void RDACprobe::addCandidate(const QString &portName)
+{
+	QSerialPort *port = new QSerialPort(portName, this);
+	port->setBaudRate(QSerialPort::Baud38400);
+	port->setDataBits(QSerialPort::Data8);
+	port->setParity(QSerialPort::NoParity);
+	port->setStopBits(QSerialPort::OneStop);
+	port->setFlowControl(QSerialPort::NoFlowControl);
+	if(!port->open(QIODevice::ReadWrite))
+	{
+		delete port;
+		return;
+	}
+
+	Candidate *candidate = new Candidate;
+	candidate->port = port;
+	candidates.append(candidate);
+	connect(port, SIGNAL(readyRead()), this, SLOT(readCandidate()));
+}
+
+/*! \brief Feeds the bytes of one candidate port into its parser and looks for a valid frame
+*/
+void RDACprobe::readCandidate()
+{
+	QSerialPort *port = qobject_cast<QSerialPort *>(sender());
+	Candidate *candidate = 0;
+	foreach(Candidate *c, candidates)
+	{
+		if(c->port == port)
+		{
+			candidate = c;
+			break;
+		}
+	}
+	if(!candidate)
+	{
+		return;
+	}
+
+	char chunk[256];
+	RDACframe frame;
+	qint64 length;
+	while((length = port->read(chunk, qMin(qint64(sizeof(chunk)), qint64(candidate->parser.freeSpace())))) > 0)
+	{
+		candidate->parser.append(chunk, int(length));
+		RDACparser::rdacResults result;
+		while((result = candidate->parser.nextFrame(frame)) != RDACparser::rdacResultMessageIncomplete)
+		{
+			if(result != RDACparser::rdacResultMessageComplete)
+			{
+				continue;
+			}
+
+			// Release the winning port before the others get closed
+			qDebug() << "Found RDAC on" << port->portName();
+			port->disconnect(this);
+			port->setParent(0);
+			candidate->port = 0;
+			stop();
+			emit portFound(port);
+			return;
+		}
+	}
+}
+
+void RDACprobe::probeTimedOut()
+{
+	qDebug() << "No RDAC found on any serial port";
+	stop();
+	emit probeFailed();
+}
@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef RDACPROBE_H
+#define RDACPROBE_H
+
+#include <QtCore>
+#include <QtSerialPort/QSerialPort>
+#include <QtSerialPort/QSerialPortInfo>
+#include "rdacparser.h"
+
+//! RDAC Probe Class
+/*!
+ * This class finds the serial port the RDAC is connected to. All free ports are opened at the
+ * same time and each one gets its own parser; the first port that delivers a frame with valid
+ * checksums wins and is handed over still open, all others are closed again. Ports that are not
+ * enumerated by the system, like pseudo-terminals, can be added by their device path, ports that
+ * belong to other devices can be excluded by name or device path.
+*/
+
+class RDACprobe : public QObject
+{
+	Q_OBJECT
+public:
+	explicit RDACprobe(QObject *parent = 0);
+	~RDACprobe();
+	void start(const QStringList &extraPorts, const QStringList &excludedPorts, int timeout);
+	void stop();
+private:
+	struct Candidate
+	{
+		QSerialPort *port;
+		RDACparser parser;
+	};
+	QList<Candidate *> candidates;
+	QTimer timeoutTimer;
+	void addCandidate(const QString &portName);
+private slots:
+	void readCandidate();
+	void probeTimedOut();
+signals:
+	void portFound(QSerialPort *port);
+	void probeFailed();
+};
+
+#endif // RDACPROBE_H
@@ -0,0 +1,206 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2012 Tobias Rad                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef RDACPROTOCOL_H
+#define RDACPROTOCOL_H
+
+#include <QtCore>
+
+//! RDAC Protocol Description
+/*!
+ * Every message of the MGL RDAC starts with the sync bytes 0x05 0x02 followed by the message
+ * type, and ends with two checksum bytes. All fields are little endian 16 bit words. The
+ * tables below describe each message type once; framing, checksum verification and field
+ * extraction in RDACparser are all driven from them.
+*/
+
+struct RDACfieldDescriptor
+{
+	const char *name;
+	quint8 offset; // Byte offset relative to the start of the payload
+	qreal scale;
+	qreal bias; // value = raw * scale + bias
+};
+
+struct RDACmessageDescriptor
+{
+	quint8 type;
+	quint8 length; // Complete frame including sync and checksums
+	quint8 payloadOffset;
+	quint8 fieldCount;
+	const RDACfieldDescriptor *fields;
+};
+
+enum RDACmessage1Field {
+	RDACm1Flow1,
+	RDACm1PulseRatio1,
+	RDACm1Flow2,
+	RDACm1PulseRatio2,
+	RDACm1Thermocouple1,
+	RDACm1Thermocouple12 = RDACm1Thermocouple1 + 11,
+	RDACm1OilTemp,
+	RDACm1OilPress,
+	RDACm1Aux1,
+	RDACm1Aux2,
+	RDACm1FuelPress,
+	RDACm1Coolant,
+	RDACm1FuelLevel1,
+	RDACm1FuelLevel2,
+	RDACm1Rpm1,
+	RDACm1Rpm2,
+	RDACm1Map,
+	RDACm1Current,
+	RDACm1InternalTemp,
+	RDACm1Volts,
+	RDACm1FieldCount
+};
+
+enum RDACmessage2Field {
+	RDACm2OilTemperature,
+	RDACm2OilPressure,
+	RDACm2FuelLevel1,
+	RDACm2FuelLevel2,
+	RDACm2Voltage,
+	RDACm2InternalTemperature,
+	RDACm2Cht1,
+	RDACm2Cht2,
+	RDACm2ManifoldPressure,
+	RDACm2FieldCount
+};
+
+enum RDACmessage3Field {
+	RDACm3TimeBetweenPulses,
+	RDACm3FieldCount
+};
+
+enum RDACmessage4Field {
+	RDACm4Thermocouple1,
+	RDACm4Thermocouple12 = RDACm4Thermocouple1 + 11,
+	RDACm4FieldCount
+};
+
+// Flow is reported as pulses per 4 second period and converted to pulses per hour.
+// Analog sender inputs are scaled from the 12 bit ADC reading to volts at the input, the
+// sender specific conversion happens in SensorConvert. Internal temperature is in degree C.
+static Q_DECL_CONSTEXPR RDACfieldDescriptor rdacMessage1Fields[] = {
+	{"flow1",          0, 900.0, 0.0},
+	{"pulseRatio1",    2, 1.0, 0.0},
+	{"flow2",          4, 900.0, 0.0},
+	{"pulseRatio2",    6, 1.0, 0.0},
+	{"thermocouple1",  8, 1.0, 0.0},
+	{"thermocouple2", 10, 1.0, 0.0},
+	{"thermocouple3", 12, 1.0, 0.0},
+	{"thermocouple4", 14, 1.0, 0.0},
+	{"thermocouple5", 16, 1.0, 0.0},
+	{"thermocouple6", 18, 1.0, 0.0},
+	{"thermocouple7", 20, 1.0, 0.0},
+	{"thermocouple8", 22, 1.0, 0.0},
+	{"thermocouple9", 24, 1.0, 0.0},
+	{"thermocouple10", 26, 1.0, 0.0},
+	{"thermocouple11", 28, 1.0, 0.0},
+	{"thermocouple12", 30, 1.0, 0.0},
+	{"oilTemp",       32, 5.0 / 4096.0, 0.0},
+	{"oilPress",      34, 5.0 / 4096.0, 0.0},
+	{"aux1",          36, 5.0 / 4096.0, 0.0},
+	{"aux2",          38, 5.0 / 4096.0, 0.0},
+	{"fuelPress",     40, 5.0 / 4096.0, 0.0},
+	{"coolant",       42, 5.0 / 4096.0, 0.0},
+	{"fuelLevel1",    44, 5.0 / 4096.0, 0.0},
+	{"fuelLevel2",    46, 5.0 / 4096.0, 0.0},
+	{"rpm1",          48, 1.0, 0.0},
+	{"rpm2",          50, 1.0, 0.0},
+	{"map",           52, 5.0 / 4096.0, 0.0},
+	{"current",       54, 5.0 / 4096.0, 0.0},
+	{"internalTemp",  56, 1.0, 0.0},
+	{"volts",         58, 0.1 / 5.73758, 0.0}
+};
+
+static Q_DECL_CONSTEXPR RDACfieldDescriptor rdacMessage2Fields[] = {
+	{"oilTemperature",       0, 1.0, 0.0},
+	{"oilPressure",          2, 1.0, 0.0},
+	{"fuelLevel1",           4, 1.0, 0.0},
+	{"fuelLevel2",           6, 1.0, 0.0},
+	{"voltage",              8, 1.0, 0.0},
+	{"internalTemperature", 10, 0.01, 0.0},
+	{"cht1",                12, 0.01, 0.0},
+	{"cht2",                14, 1.0, 0.0},
+	{"manifoldPressure",    16, 1.0, 0.0}
+};
+
+static Q_DECL_CONSTEXPR RDACfieldDescriptor rdacMessage3Fields[] = {
+	{"timeBetweenPulses", 0, 1.0, 0.0}
+};
+
+static Q_DECL_CONSTEXPR RDACfieldDescriptor rdacMessage4Fields[] = {
+	{"thermocouple1",   0, 1.0, 0.0},
+	{"thermocouple2",   2, 1.0, 0.0},
+	{"thermocouple3",   4, 1.0, 0.0},
+	{"thermocouple4",   6, 1.0, 0.0},
+	{"thermocouple5",   8, 1.0, 0.0},
+	{"thermocouple6",  10, 1.0, 0.0},
+	{"thermocouple7",  12, 1.0, 0.0},
+	{"thermocouple8",  14, 1.0, 0.0},
+	{"thermocouple9",  16, 1.0, 0.0},
+	{"thermocouple10", 18, 1.0, 0.0},
+	{"thermocouple11", 20, 1.0, 0.0},
+	{"thermocouple12", 22, 1.0, 0.0}
+};
+
+// Indexed by message type - 1
+static Q_DECL_CONSTEXPR RDACmessageDescriptor rdacMessages[] = {
+	{0x01, 66, 4, RDACm1FieldCount, rdacMessage1Fields},
+	{0x02, 23, 3, RDACm2FieldCount, rdacMessage2Fields},
+	{0x03,  7, 3, RDACm3FieldCount, rdacMessage3Fields},
+	{0x04, 29, 3, RDACm4FieldCount, rdacMessage4Fields}
+};
+
+enum {
+	RDACmessageTypeCount = sizeof(rdacMessages) / sizeof(rdacMessages[0]),
+	RDACmaxFrameLength = 66,
+	RDACmaxFieldCount = RDACm1FieldCount
+};
+
+Q_STATIC_ASSERT(sizeof(rdacMessage1Fields) / sizeof(RDACfieldDescriptor) == RDACm1FieldCount);
+Q_STATIC_ASSERT(sizeof(rdacMessage2Fields) / sizeof(RDACfieldDescriptor) == RDACm2FieldCount);
+Q_STATIC_ASSERT(sizeof(rdacMessage3Fields) / sizeof(RDACfieldDescriptor) == RDACm3FieldCount);
+Q_STATIC_ASSERT(sizeof(rdacMessage4Fields) / sizeof(RDACfieldDescriptor) == RDACm4FieldCount);
+Q_STATIC_ASSERT(rdacMessages[0].payloadOffset + 2 * RDACm1FieldCount + 2 == rdacMessages[0].length);
+Q_STATIC_ASSERT(rdacMessages[1].payloadOffset + 2 * RDACm2FieldCount + 2 == rdacMessages[1].length);
+Q_STATIC_ASSERT(rdacMessages[2].payloadOffset + 2 * RDACm3FieldCount + 2 == rdacMessages[2].length);
+Q_STATIC_ASSERT(rdacMessages[3].payloadOffset + 2 * RDACm4FieldCount + 2 == rdacMessages[3].length);
+
+//! Returns the descriptor of a message type or a null pointer if the type is unknown
+inline Q_DECL_CONSTEXPR const RDACmessageDescriptor *rdacDescriptor(quint8 type)
+{
+	return (type >= 1 && type <= RDACmessageTypeCount) ? &rdacMessages[type - 1] : Q_NULLPTR;
+}
+
+//! Extracts and scales every field of a message from its payload into values
+inline void rdacDecodeFields(const RDACmessageDescriptor &descriptor, const quint8 *payload, qreal *values)
+{
+	for(int i = 0; i < descriptor.fieldCount; ++i)
+	{
+		const RDACfieldDescriptor &field = descriptor.fields[i];
+		const quint16 raw = quint16(payload[field.offset] | (payload[field.offset + 1] << 8));
+		values[i] = raw * field.scale + field.bias;
+	}
+}
+
+#endif // RDACPROTOCOL_H
@@ -0,0 +1,114 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "rdacreplay.h"
+
+// Records handed out per timer tick when replaying as fast as possible
+static const int fastReplayBatch = 256;
+
+RDACreplay::RDACreplay(QObject *parent) : QObject(parent)
+  , pendingTimestamp(0)
+  , hasPending(false)
+  , firstTimestamp(0)
+  , speed(1.0)
+  , looping(false)
+{
+	timer.setSingleShot(true);
+	connect(&timer, SIGNAL(timeout()), this, SLOT(replayDue()));
+}
+
+bool RDACreplay::start(const QString &fileName, qreal replaySpeed, bool loop)
+{
+	if(!reader.open(fileName))
+	{
+		return false;
+	}
+	speed = qMax(replaySpeed, 0.0);
+	looping = loop;
+
+	if(!readNext())
+	{
+		qWarning() << "RDAC capture" << fileName << "is empty";
+		return false;
+	}
+	firstTimestamp = pendingTimestamp;
+	clock.start();
+	timer.start(0);
+	qDebug() << "Replaying RDAC capture" << fileName << "at speed" << speed;
+	return true;
+}
+
+void RDACreplay::stop()
+{
+	timer.stop();
+	reader.close();
+	hasPending = false;
+}
+
+bool RDACreplay::readNext()
+{
+	hasPending = reader.next(pendingTimestamp, pending);
+	if(!hasPending && looping)
+	{
+		reader.rewind();
+		hasPending = reader.next(pendingTimestamp, pending);
+		firstTimestamp = pendingTimestamp;
+		clock.restart();
+	}
+	return hasPending;
+}
+
+/*! \brief Emits every record whose time has come and schedules the next one
+*
+* If the ready check fails the record is held back and tried again on the next tick.
+*/
+void RDACreplay::replayDue()
+{
+	int batch = 0;
+	while(hasPending)
+	{
+		if(speed > 0.0)
+		{
+			const qint64 due = qint64((pendingTimestamp - firstTimestamp) / speed);
+			const qint64 wait = due - clock.nsecsElapsed();
+			if(wait > 0)
+			{
+				timer.start(int(qMax<qint64>(wait / 1000000, 1)));
+				return;
+			}
+		}
+		else if(batch++ == fastReplayBatch)
+		{
+			timer.start(0);
+			return;
+		}
+		if(readyCheck && !readyCheck())
+		{
+			timer.start(1);
+			return;
+		}
+
+		emit bytesReplayed(pending);
+		readNext();
+	}
+
+	qDebug() << "RDAC capture replay finished";
+	emit finished();
+}
@@ -0,0 +1,64 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef RDACREPLAY_H
+#define RDACREPLAY_H
+
+#include <QtCore>
+#include <functional>
+#include "rdaccapture.h"
+
+//! RDAC Replay Class
+/*!
+ * This class plays an RDAC capture back as if it was coming from the serial port. A speed of
+ * 1.0 reproduces the original timing, larger values replay N times faster and 0 replays as
+ * fast as possible, in batches so the owning thread's event loop keeps running. With a ready
+ * check set, a record is only replayed once the check passes, so the receiver is never
+ * flooded; as fast as possible then means as fast as the receiver takes the data.
+*/
+
+class RDACreplay : public QObject
+{
+	Q_OBJECT
+public:
+	explicit RDACreplay(QObject *parent = 0);
+	bool start(const QString &fileName, qreal replaySpeed = 1.0, bool loop = false);
+	void stop();
+	void setReadyCheck(const std::function<bool()> &check) {readyCheck = check;}
+private:
+	RDACcaptureReader reader;
+	QTimer timer;
+	QElapsedTimer clock;
+	QByteArray pending;
+	quint64 pendingTimestamp;
+	bool hasPending;
+	quint64 firstTimestamp;
+	qreal speed;
+	bool looping;
+	std::function<bool()> readyCheck;
+	bool readNext();
+private slots:
+	void replayDue();
+signals:
+	void bytesReplayed(const QByteArray &data);
+	void finished();
+};
+
+#endif // RDACREPLAY_H
@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "readouttext.h"
+
+ReadoutText::ReadoutText() : precision(0)
+  , shownValue(0)
+  , hasValue(false)
+{
+	staticText.setTextFormat(Qt::PlainText);
+}
+
+void ReadoutText::setFont(const QFont &newFont)
+{
+	font = newFont;
+	staticText.prepare(QTransform(), font);
+}
+
+void ReadoutText::setPrecision(int digits)
+{
+	if(digits != precision)
+	{
+		precision = digits;
+		hasValue = false;
+	}
+}
+
+void ReadoutText::setText(const QString &text)
+{
+	hasValue = false;
+	if(text != staticText.text())
+	{
+		layout(text);
+	}
+}
+
+/*! \brief Shows value with the set number of decimals
+*/
+void ReadoutText::setValue(double value)
+{
+	const qint64 rounded = qRound64(value * qPow(10.0, precision));
+	if(hasValue && rounded == shownValue)
+	{
+		return;
+	}
+	shownValue = rounded;
+	hasValue = true;
+	layout(QString::number(value, 'f', precision));
+}
+
+void ReadoutText::layout(const QString &text)
+{
+	staticText.setText(text);
+	staticText.prepare(QTransform(), font);
+}
+
+/*! \brief Draws the text aligned within rect with the painter's pen
+*/
+void ReadoutText::draw(QPainter *painter, const QRectF &rect, Qt::Alignment alignment) const
+{
+	const QSizeF size = staticText.size();
+	QPointF position = rect.topLeft();
+	if(alignment & Qt::AlignRight)
+	{
+		position.setX(rect.right() - size.width());
+	}
+	else if(alignment & Qt::AlignHCenter)
+	{
+		position.setX(rect.center().x() - size.width() / 2.0);
+	}
+	if(alignment & Qt::AlignBottom)
+	{
+		position.setY(rect.bottom() - size.height());
+	}
+	else if(alignment & Qt::AlignVCenter)
+	{
+		position.setY(rect.center().y() - size.height() / 2.0);
+	}
+	painter->setFont(font);
+	painter->drawStaticText(position, staticText);
+}
@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef READOUTTEXT_H
+#define READOUTTEXT_H
+
+#include <QtGui>
+
+//! Readout Text Class
+/*!
+ * A text with its own font whose glyph layout is kept in a QStaticText. For numeric readouts the
+ * string is only rebuilt and laid out again when the value, rounded to the shown precision,
+ * changes; drawing an unchanged readout does not touch QString or the text shaper.
+*/
+
+class ReadoutText
+{
+public:
+	ReadoutText();
+	void setFont(const QFont &newFont);
+	void setPrecision(int digits);
+	void setText(const QString &text);
+	void setValue(double value);
+	void draw(QPainter *painter, const QRectF &rect, Qt::Alignment alignment = Qt::AlignCenter) const;
+private:
+	void layout(const QString &text);
+	QStaticText staticText;
+	QFont font;
+	int precision;
+	qint64 shownValue; // Value in units of the last shown digit
+	bool hasValue;
+};
+
+#endif // READOUTTEXT_H
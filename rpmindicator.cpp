@@ -19,6 +19,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "rpmindicator.h"
+#include "paintprofiler.h"
 
 RpmIndicator::RpmIndicator(QGraphicsObject *parent) : QGraphicsObject(parent)
   , minValue(0.0)
@@ -32,6 +33,11 @@ RpmIndicator::RpmIndicator(QGraphicsObject *parent) : QGraphicsObject(parent)
     isWarmup=true;
 
     gauge.setGauge("RPM");
+
+    rpmReadout.setFont(QFont("Arial", 30, QFont::Bold));
+    rpmReadout.setValue(currentValue);
+    unitReadout.setFont(QFont("Arial", 20, 1));
+    unitReadout.setText("RPM");
 }
 
 
@@ -40,15 +46,10 @@ QRectF RpmIndicator::boundingRect() const
 	return QRectF(-200.0, -140.0, 400.0, 280.0);
 }
 
-/*! \brief Handles drawing of the object
-*
-* This member handles all of the painting logic used to draw the item and the associated style.
+/*! \brief Draws the ranges, ticks and labels, which are cached by paint()
 */
-void RpmIndicator::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+void RpmIndicator::paintBackground(QPainter *painter)
 {
-	Q_UNUSED(option);
-    Q_UNUSED(widget);
-
 	//Draw the arc
     QRectF circle = QRectF(-130.0, -130.0, 260.0, 260.0);
 
@@ -109,6 +110,25 @@ void RpmIndicator::paint(QPainter *painter, const QStyleOptionGraphicsItem *opti
 	//Draw the center text
 	QRectF centerTextRect(-50, -50, 100, 100);
 	painter->drawText(centerTextRect, Qt::AlignCenter, "x 100 rpm");
+}
+
+/*! \brief Handles drawing of the object
+*
+* This member handles all of the painting logic used to draw the item and the associated style.
+*/
+void RpmIndicator::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+	PaintProfiler::Scope profile(this);
+	Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    //Draw the static layer from the cache, it only changes with the configuration
+    if (!backgroundCache.isValid(painter)) {
+        QPainter cachePainter;
+        backgroundCache.beginUpdate(&cachePainter, painter, boundingRect());
+        paintBackground(&cachePainter);
+    }
+    backgroundCache.draw(painter);
 
 	//Draw the needle if value is in range
 	if((currentValue > minValue) &&
@@ -131,122 +151,39 @@ void RpmIndicator::paint(QPainter *painter, const QStyleOptionGraphicsItem *opti
 		painter->restore();
 	}
 
-    i=0;
-    painter->setPen(Qt::blue);
-
-    for (i=0; i<numOfRanges; i++) {
-        if (isWarmup) {
-            startVal = gauge.warmupDefinitions[i].start;
-            endVal = gauge.warmupDefinitions[i].end;
-            color = gauge.warmupDefinitions[i].color;
-
-        } else {
-            startVal = gauge.definitions[i].start;
-            endVal = gauge.definitions[i].end;
-            color = gauge.definitions[i].color;
-
-        }
-
-        if (startVal <= currentValue && currentValue < endVal) {
-            if (color == Qt::red) {
-                if (flashState == false && isAcknowledged == false) {
-
-                    painter->setPen(Qt::red);
-
-                } else if (flashState == true || isAcknowledged == true) {
-                    painter->setPen(Qt::red);
-                    painter->setBrush(Qt::red);
-
-                    painter->drawRect(QRectF(-40, 45, 190, 45));
-
-                    painter->setPen(Qt::white);
-                }
+    //Color the readout according to the alarm state
+    painter->setPen(Qt::white);
+    if (isAlarmedRed || isAlarmedYellow) {
+        const QColor alarmColor = isAlarmedRed ? Qt::red : Qt::yellow;
+        painter->setPen(alarmColor);
 
-                if (isAlarmedRed == false) {
-                    //emit sendAlarm("RPM", Qt::red, true);
-                    isAlarmedRed = true;
-                    isAcknowledged = false;
-                }
-
-            } else if (color == Qt::yellow) {
-                if (flashState == false && isAcknowledged == false) {
-
-                    painter->setPen(Qt::yellow);
-
-                } else if (flashState == true || isAcknowledged == true) {
-                    painter->setPen(Qt::yellow);
-                    painter->setBrush(Qt::yellow);
-
-                    painter->drawRect(QRectF(-40, 45, 190, 45));
-
-                    painter->setPen(Qt::black);
-                }
-
-                if (isAlarmedYellow == false) {
-                    //emit sendAlarm("RPM", Qt::yellow, true);
-                    isAlarmedYellow = true;
-                    isAcknowledged = false;
-                }
-            }
-        } else if (currentValue > maxValue || currentValue < minValue) {
-            if (flashState == false && isAcknowledged == false) {
-
-                painter->setPen(Qt::red);
-
-            } else if (flashState == true || isAcknowledged == true) {
-                painter->setPen(Qt::red);
-                painter->setBrush(Qt::red);
-
-                painter->drawRect(QRectF(-40, 45, 190, 45));
-
-                painter->setPen(Qt::white);
-            }
-
-            if (isAlarmedRed == false) {
-                //emit sendAlarm("RPM", Qt::red, true);
-                isAlarmedRed = true;
-                isAcknowledged = false;
-            }
-        }
-    }
-
-    if (painter->pen().color() != Qt::red && painter->pen().color() != Qt::yellow
-            && painter->pen().color() != Qt::white && painter->pen().color() != Qt::black) {
-        painter->setPen(Qt::white);
-
-        if (isAlarmedRed == true || isAlarmedYellow == true) {
-            //emit cancelAlarm("RPM");
-            isAlarmedRed = false;
-            isAlarmedYellow = false;
+        if (flashState == true || isAcknowledged == true) {
+            painter->setBrush(alarmColor);
+            painter->drawRect(QRectF(-40, 45, 190, 45));
+            painter->setPen(isAlarmedRed ? Qt::white : Qt::black);
         }
     }
 
-	//Round value to the nearest 10
-	QString rpm = QString::number(currentValue-fmod(currentValue, 10.0), 'f', 0);
-
-	//Set position and font for the value and draw it
+	//Draw the value
     QRectF textRect(-100, 35, 170, 65);
-    painter->setFont(QFont("Arial", 30, QFont::Bold));
-	painter->drawText(textRect, Qt::AlignRight | Qt::AlignVCenter, rpm);
-	//Set position and font for the unit and draw it
+    rpmReadout.draw(painter, textRect, Qt::AlignRight | Qt::AlignVCenter);
+	//Draw the unit
 	QRectF unitRect(90, 35, 100, 65);
-	painter->setFont(QFont("Arial", 20, 1));
-    painter->drawText(unitRect, Qt::AlignLeft | Qt::AlignVCenter, "RPM");
-
-    update();
-
+    unitReadout.draw(painter, unitRect, Qt::AlignLeft | Qt::AlignVCenter);
 }
 
 void RpmIndicator::setStartSpan(double start, double span)
 {
 	startAngle = start;
 	spanAngle = span;
+	backgroundCache.invalidate();
 }
 
 void RpmIndicator::setBorders(double minimum, double maximum)
 {
     minValue = minimum;
     maxValue = maximum;
+    backgroundCache.invalidate();
 }
 
 double RpmIndicator::calculateLocalValue(double value) const
@@ -257,12 +194,41 @@ double RpmIndicator::calculateLocalValue(double value) const
 void RpmIndicator::addBetweenValue(double value)
 {
 	beetweenValues.append(value);
+	backgroundCache.invalidate();
 }
 
 void RpmIndicator::setValue(double value)
 {
-	currentValue = value;
-    //update();
+    if (value != currentValue) {
+        currentValue = value;
+        //Round value to the nearest 10
+        rpmReadout.setValue(currentValue-fmod(currentValue, 10.0));
+        update();
+    }
+}
+
+/*! \brief Switches between the warmup and the normal ranges
+*/
+void RpmIndicator::setWarmup(bool warmup)
+{
+    if (warmup != isWarmup) {
+        isWarmup = warmup;
+        backgroundCache.invalidate();
+        update();
+    }
+}
+
+/*! \brief Sets the alarm state as classified by the alarm engine
+*/
+void RpmIndicator::setAlarmState(AlarmState state)
+{
+    if ((state.level == AlarmWarning) != isAlarmedRed || (state.level == AlarmCaution) != isAlarmedYellow
+            || state.acknowledged != isAcknowledged) {
+        isAlarmedRed = state.level == AlarmWarning;
+        isAlarmedYellow = state.level == AlarmCaution;
+        isAcknowledged = state.acknowledged;
+        update();
+    }
 }
 
 void RpmIndicator::changeFlashState()
@@ -272,4 +238,9 @@ void RpmIndicator::changeFlashState()
     } else {
         flashState = false;
     }
+
+    //  The readout only flashes while an alarm is not acknowledged
+    if ((isAlarmedRed || isAlarmedYellow) && !isAcknowledged) {
+        update();
+    }
 }
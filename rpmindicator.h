@@ -25,6 +25,9 @@
 #include <QtCore>
 #include <alarmBox.h>
 #include <gaugesettings.h>
+#include "alarmengine.h"
+#include "gaugecache.h"
+#include "readouttext.h"
 
 //! RPM Indicator Class
 /*!
@@ -44,12 +47,18 @@ public:
     void setBorders(double minimum, double maximum);
 	void addBetweenValue(double value);
 	void setValue(double value);
+    void setWarmup(bool warmup);
+    void setAlarmState(AlarmState state);
     double getValue() {return currentValue;};
     bool isWarmup;
     bool isAlarmedRed = false;
     bool isAlarmedYellow = false;
 private:
 	double calculateLocalValue(double value) const;
+    void paintBackground(QPainter *painter);
+    GaugeCache backgroundCache;
+    ReadoutText rpmReadout;
+    ReadoutText unitReadout;
 	double minValue, maxValue, currentValue;
     double whiteGreenBorder, greenRedBorder, yellowRedBorder, greenYellowBorder, redYellowBorder, yellowGreenBorder;
     double yellowRedBorderWarmup, greenYellowBorderWarmup, redYellowBorderWarmup, yellowGreenBorderWarmup;
@@ -62,22 +71,13 @@ private:
     int i;
     float startRange;
     float endRange;
-    float startVal;
-    float endVal;
     QColor color;
     int numOfRanges;
 
-    bool isAcknowledged;
-
-signals:
-    void sendAlarm(QString, QColor, bool);
-    void cancelAlarm(QString);
+    bool isAcknowledged = false;
 
 public slots:
     void changeFlashState();
-    void onAlarmAck() {
-        isAcknowledged = true;
-    }
 
 };
 
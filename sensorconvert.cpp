@@ -23,111 +23,383 @@
 SensorConvert::SensorConvert(QObject *parent) : QThread(parent)
   ,settings("./settings/settings.ini", QSettings::IniFormat, parent)
   ,gaugeSettings("./settings/gaugeSettings.ini", QSettings::IniFormat, parent)
+  ,temperatureUnit(TemperatureCelsius)
+  ,pressureUnit(PressureBar)
+  ,fuelUnit(VolumeLiter)
+  ,fuelFlowUnit(VolumeLiter)
+  ,rdacSamples(0)
+  ,kFactor(0.0)
+  ,fuelFlowScale(0.0)
+  ,oilTempPullup(0.0)
+  ,thermocoupleScale(1.0)
 {
     //Let's set what type of thermocouple we are using
+    // The Arduino sends either comma separated lines or binary frames
+    binaryInterface = settings.value("Sensors/interface", "arduino").toString() == "arduinobinary";
+
     setThermocoupleTypeCht(settings.value("Sensors/chtThermocoupleType", "K").toString());
     setThermocoupleTypeEgt(settings.value("Sensors/egtThermocoupleType", "K").toString());
     setTemperatureScale(settings.value("Units/temp", "F").toString());
+    pressureUnit = pressureUnitFromString(settings.value("Units/pressure", "PSI").toString());
+    fuelUnit = volumeUnitFromString(settings.value("Units/fuel", "GAL").toString());
+    fuelFlowUnit = volumeUnitFromString(settings.value("Units/fuelFlow", "GPH").toString());
     setKFactor(gaugeSettings.value("Fuel/kfactor", "F").toString().toDouble());
 
+    // Sender curves, oil temperature and pressure default to the Rotax 912ULS senders
+    // Oil temp: Aviasport data, resistance in ohm to degree C
+    // Oil press: Keller 456-180, volts to bar
+    loadCalibration(ChannelOilTemp, "oilTemp", CalibrationCurve::powerLaw(497.2, -0.397, 18.6, 322.8, "C"));
+    loadCalibration(ChannelOilPress, "oilPress", CalibrationCurve::polynomial(QVector<qreal>() << 0.75 << 0.625, 0.0, 5.0, "BAR"));
+    loadCalibration(ChannelManifoldPressure, "map");
+    loadCalibration(ChannelFuelPress, "fuelPress");
+    loadCalibration(ChannelCoolantTemp, "coolant");
+    loadCalibration(ChannelFuelLevel1, "fuelLevel1");
+    loadCalibration(ChannelFuelLevel2, "fuelLevel2");
+    loadCalibration(ChannelAmps, "current");
+    loadCalibration(ChannelAux1, "aux1");
+    loadCalibration(ChannelAux2, "aux2");
+
+    // Convert straight into the display units, the curves' tables absorb the conversion
+    convertCurveToDisplay(ChannelOilTemp, temperatureUnit);
+    convertCurveToDisplay(ChannelCoolantTemp, temperatureUnit);
+    convertCurveToDisplay(ChannelOilPress, pressureUnit);
+    convertCurveToDisplay(ChannelFuelPress, pressureUnit);
+    convertCurveToDisplay(ChannelFuelLevel1, fuelUnit);
+    convertCurveToDisplay(ChannelFuelLevel2, fuelUnit);
+
+    // The oil temperature sender is a resistor to ground, pulled up to 5 V inside the RDAC
+    oilTempPullup = settings.value("Sensors/oilTempPullup", 0.0).toDouble();
+
+    // Microvolts per count of the RDAC thermocouple inputs
+    thermocoupleScale = settings.value("Sensors/thermocoupleScale", 1.0).toDouble();
+
+    // Samples from the RDAC thread are picked up once per display frame, at Display/maxFps like
+    // the FrameScheduler, so the gauges are not updated more often than they are painted
+    connect(&drainTimer, SIGNAL(timeout()), this, SLOT(drainRdacSamples()));
 }
 
-void SensorConvert::convertOilTemp(double resistance)
+void SensorConvert::setRdacSampleQueue(RDACsampleQueue *queue)
 {
-    double temp;
+    rdacSamples = queue;
+    drainTimer.start(1000 / qBound(1, settings.value("Display/maxFps", 30).toInt(), 1000));
+}
 
-    // Function created from data used by Aviasport Oil Temp instrument
-    //  This equation produces a temperature in Celsius
-    //  Rotax 912ULS
-    if (resistance <= 322.8 && resistance >= 18.6) {
-        temp = 497.2 * pow(resistance, -0.397);
-    }
-    else {
-        temp = -999;
-    }
+/*! \brief Loads the curve named by Sensors/<name>Curve, or Calibration/<name> if that is not set
+*/
+void SensorConvert::loadCalibration(EngineChannel channel, QString name, const CalibrationCurve &fallback)
+{
+    calibration[channel] = fallback;
+    calibration[channel].load(settings, settings.value(QString("Sensors/%1Curve").arg(name), name).toString());
+}
+
+void SensorConvert::convertCurveToDisplay(EngineChannel channel, TemperatureUnit unit)
+{
+    calibration[channel].convertOutput(unitConversion(temperatureUnitFromString(calibration[channel].unit()), unit));
+}
+
+void SensorConvert::convertCurveToDisplay(EngineChannel channel, PressureUnit unit)
+{
+    calibration[channel].convertOutput(unitConversion(pressureUnitFromString(calibration[channel].unit()), unit));
+}
+
+void SensorConvert::convertCurveToDisplay(EngineChannel channel, VolumeUnit unit)
+{
+    calibration[channel].convertOutput(unitConversion(volumeUnitFromString(calibration[channel].unit()), unit));
+}
 
-    // If our desired scale is not celsius, then we need to convert it
-    if (temperatureScale != "C")
-    {
-        temp = convertTemperature(temp);
+/*! \brief Converts a sender reading with the channel's curve
+*
+* The channel is marked invalid if it has no curve or the reading is outside of it.
+*/
+bool SensorConvert::convertCalibrated(EngineChannel channel, double input)
+{
+    qreal value;
+    if (!calibration[channel].convert(input, value)) {
+        sample.invalidate(channel);
+        return false;
     }
+    sample.set(channel, value);
+    return true;
+}
+
+void SensorConvert::convertOilTemp(double resistance)
+{
+    qreal temp;
 
-    oilTemp = temp;
+    // The curve already produces a temperature in the display scale, a reading outside of it
+    // leaves the channel invalid instead of passing an error value on as a temperature
+    if (!calibration[ChannelOilTemp].convert(resistance, temp)) {
+        sample.invalidate(ChannelOilTemp);
+        return;
+    }
 
+    sample.set(ChannelOilTemp, temp);
 }
 
 void SensorConvert::convertFuelFlow(qreal pulses)
 {
     // User enters k factor which is pulse for one volumetric unit of fluid.
     // The eninge interface data will be coming in pulses per hour.
-    fuelFlow = pulses / kFactor;
+    if (kFactor > 0.0) {
+        sample.set(ChannelFuelFlow, pulses * fuelFlowScale);
+    }
 }
 
 void SensorConvert::convertRpm(double pulses)
 {
     // The Rotax sendor sends one pulse for every crankshaft revolution
     //  SO we just return the number of pulses until we hear something different
-    rpm =  pulses;
+    sample.set(ChannelRpm, pulses);
 }
 
-void SensorConvert::convertOilPress(double voltage)
+void SensorConvert::convertVolts(double voltage)
 {
-    // 456-180 (Keller)
-    oilPress =  0.625*voltage + 0.75;
+    // Round to a tenth of a volt
+    sample.set(ChannelVolts, round(voltage * 10.0) * 0.1);
 }
 
-void SensorConvert::convertOat(double sensorValue)
+void SensorConvert::convertOilPress(double voltage)
 {
-    oat = sensorValue;
+    convertCalibrated(ChannelOilPress, voltage);
 }
 
-void SensorConvert::convertIat(double sensorValue)
+void SensorConvert::convertOat(double sensorValue)
 {
-    iat = sensorValue;
+    sample.set(ChannelOat, sensorValue);
 }
 
-double SensorConvert::convertTemperature(double temp)
+void SensorConvert::convertIat(double sensorValue)
 {
-    // COde needs to be added to convert to different units
-    return temp;
+    sample.set(ChannelIat, sensorValue);
 }
 
 void SensorConvert::setThermocoupleTypeCht(QString type)
 {
     thermocoupleTypeCht = type;
+    chtTable.setType(type == "J" ? ThermocoupleTable::TypeJ : ThermocoupleTable::TypeK);
 }
 
 void SensorConvert::setThermocoupleTypeEgt(QString type)
 {
     thermocoupleTypeEgt = type;
+    egtTable.setType(type == "J" ? ThermocoupleTable::TypeJ : ThermocoupleTable::TypeK);
 }
 
 void SensorConvert::setTemperatureScale(QString scale)
 {
-    temperatureScale = scale;
+    // The thermocouple tables produce the display scale directly
+    temperatureUnit = temperatureUnitFromString(scale);
+    const UnitConversion conversion = unitConversion(TemperatureCelsius, temperatureUnit);
+    egtTable.setOutputConversion(conversion);
+    chtTable.setOutputConversion(conversion);
 }
 
+static const EngineChannel egtChannels[] = {ChannelEgt1, ChannelEgt2, ChannelEgt3, ChannelEgt4, ChannelEgt5, ChannelEgt6};
+static const EngineChannel chtChannels[] = {ChannelCht1, ChannelCht2, ChannelCht3, ChannelCht4, ChannelCht5, ChannelCht6};
+
 void SensorConvert::convertCht(double volt1, double volt2, double volt3, double volt4)
 {
-
+    const qreal microvolts[] = {volt1 * 1e6, volt2 * 1e6, volt3 * 1e6, volt4 * 1e6};
+    convertThermocouples(microvolts, chtChannels, 4, chtTable);
 }
 
 void SensorConvert::convertEgt(double volt1, double volt2, double volt3, double volt4)
 {
+    const qreal microvolts[] = {volt1 * 1e6, volt2 * 1e6, volt3 * 1e6, volt4 * 1e6};
+    convertThermocouples(microvolts, egtChannels, 4, egtTable);
+}
+
+/*! \brief Returns the temperature of the thermocouple terminals in degree C
+*
+* The terminals are inside the RDAC, so its internal temperature is used if it was received.
+*/
+Celsius SensorConvert::coldJunctionTemperature() const
+{
+    return Celsius(sample.isValid(ChannelInternalTemp) ? sample.value[ChannelInternalTemp] : 25.0);
+}
 
+/*! \brief Linearizes a batch of thermocouples of the same type into the given channels
+*/
+void SensorConvert::convertThermocouples(const qreal *microvolts, const EngineChannel *channels, int count, const ThermocoupleTable &table)
+{
+    qreal temperatures[6];
+    Q_ASSERT(count <= 6);
+    table.convert(microvolts, temperatures, count, coldJunctionTemperature());
+    for (int i = 0; i < count; ++i) {
+        sample.set(channels[i], temperatures[i]);
+    }
 }
 
-void SensorConvert::onRdacUpdate(qreal fuelFlowPulses, qreal voltage) {
-    convertFuelFlow(fuelFlowPulses);
+/*! \brief Converts everything the RDAC thread queued since the last display frame
+*
+* Every converted sample is passed on with sampleConverted(), so alarms see each one, but the
+* monitor is only updated once per call, no matter how many samples were waiting.
+*/
+void SensorConvert::drainRdacSamples() {
+    RDACsample rdacSample;
+    bool updated = false;
+
+    while (rdacSamples->pop(rdacSample)) {
+        convertRdacMessage1(rdacSample);
+        emit sampleConverted(sample);
+        updated = true;
+    }
 
-    emit updateMonitor(rpm, fuelFlow, oilTemp, oilPress, amps, voltage, egt1, egt2, egt3, egt4, cht1, cht2, cht3, cht4, oat, iat);
+    if (updated) {
+        emit updateMonitor(sample);
+    }
 }
 
+/*! \brief Converts every field of one RDAC message 1 into the sample
+*/
+void SensorConvert::convertRdacMessage1(const RDACsample &rdacSample)
+{
+    const qreal *value = rdacSample.value;
+    sample.timestamp = rdacSample.timestamp;
+
+    convertFuelFlow(value[RDACm1Flow1]);
+    if (kFactor > 0.0) {
+        sample.set(ChannelFuelFlow2, value[RDACm1Flow2] * fuelFlowScale);
+    }
+    convertRpm(value[RDACm1Rpm1]);
+    sample.set(ChannelRpm2, value[RDACm1Rpm2]);
+    convertVolts(value[RDACm1Volts]);
+    convertOilPress(value[RDACm1OilPress]);
+
+    const qreal oilTempVoltage = value[RDACm1OilTemp];
+    if (oilTempPullup > 0.0 && oilTempVoltage < 5.0) {
+        convertOilTemp(oilTempPullup * oilTempVoltage / (5.0 - oilTempVoltage));
+    }
+
+    convertCalibrated(ChannelManifoldPressure, value[RDACm1Map]);
+    convertCalibrated(ChannelFuelPress, value[RDACm1FuelPress]);
+    convertCalibrated(ChannelCoolantTemp, value[RDACm1Coolant]);
+    convertCalibrated(ChannelFuelLevel1, value[RDACm1FuelLevel1]);
+    convertCalibrated(ChannelFuelLevel2, value[RDACm1FuelLevel2]);
+    convertCalibrated(ChannelAmps, value[RDACm1Current]);
+    convertCalibrated(ChannelAux1, value[RDACm1Aux1]);
+    convertCalibrated(ChannelAux2, value[RDACm1Aux2]);
+    sample.set(ChannelInternalTemp, value[RDACm1InternalTemp]);
+
+    // Thermocouples 1-4 and 9-10 are EGT, 5-8 and 11-12 are CHT
+    static const int egtInputs[] = {0, 1, 2, 3, 8, 9};
+    static const int chtInputs[] = {4, 5, 6, 7, 10, 11};
+    const qreal *thermocouple = value + RDACm1Thermocouple1;
+    qreal egtMicrovolts[6];
+    qreal chtMicrovolts[6];
+    for (int i = 0; i < 6; ++i) {
+        egtMicrovolts[i] = thermocouple[egtInputs[i]] * thermocoupleScale;
+        chtMicrovolts[i] = thermocouple[chtInputs[i]] * thermocoupleScale;
+    }
+    convertThermocouples(egtMicrovolts, egtChannels, 6, egtTable);
+    convertThermocouples(chtMicrovolts, chtChannels, 6, chtTable);
+}
+
+/*! \brief Sets the pulses per volume unit of the fuel flow sender
+*
+* The k factor is given per Fuel/kfactorUnit, by default the unit fuel flow is shown in.
+*/
 void SensorConvert::setKFactor(qreal kFac) {
     kFactor = kFac;
+    const VolumeUnit kFactorUnit = volumeUnitFromString(gaugeSettings.value("Fuel/kfactorUnit", settings.value("Units/fuelFlow", "GPH")).toString());
+    fuelFlowScale = kFactor > 0.0 ? unitConversion(kFactorUnit, fuelFlowUnit).scale / kFactor : 0.0;
+}
+
+// Number of comma separated fields in a line from the sensor interface
+static const int sensorFieldCount = ArduinoFieldCount;
+
+/*! \brief Parses a decimal number in place and advances p behind it
+*
+* Does not depend on the locale and never allocates.
+*/
+static bool parseNumber(const char *&p, const char *end, qreal &value)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    qreal result = 0.0;
+    int digits = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10.0 + (*p - '0');
+        ++p;
+        ++digits;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        qreal scale = 0.1;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result += (*p - '0') * scale;
+            scale *= 0.1;
+            ++p;
+            ++digits;
+        }
+    }
+
+    value = negative ? -result : result;
+    return digits > 0;
 }
 
-void SensorConvert::processData(QString data)
+/*! \brief Splits one line into exactly count numbers in a single pass
+*
+* Returns false for malformed lines, i.e. missing, additional or non numeric fields.
+*/
+static bool parseSensorLine(const QByteArray &line, qreal *fields, int count)
+{
+    const char *p = line.constData();
+    const char *end = p + line.size();
+    while (end > p && (end[-1] == '\n' || end[-1] == '\r' || end[-1] == ' ')) {
+        --end;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+        if (!parseNumber(p, end, fields[i])) {
+            return false;
+        }
+        while (p < end && *p == ' ') {
+            ++p;
+        }
+        if (i < count - 1) {
+            if (p == end || *p != ',') {
+                return false;
+            }
+            ++p;
+        }
+    }
+    return p == end;
+}
+
+/*! \brief Converts data received from the Arduino sensor interface
+*
+* With Sensors/interface=arduinobinary data may be any chunk of the binary stream and every
+* complete frame in it is converted, otherwise data is one comma separated line.
+*/
+void SensorConvert::processData(const QByteArray &data)
+{
+    if (binaryInterface) {
+        const char *p = data.constData();
+        const char *end = p + data.size();
+        while (p < end) {
+            if (arduinoParser.feed(p, end) == ArduinoParser::arduinoResultMessageComplete) {
+                convertSensorFields(arduinoParser.values());
+            }
+        }
+        return;
+    }
+
+    qreal field[sensorFieldCount];
+    if (!parseSensorLine(data, field, sensorFieldCount)) {
+        return;
+    }
+    convertSensorFields(field);
+}
+
+void SensorConvert::convertSensorFields(const qreal *field)
 {
     // Process the data string from the serial read. In the beginning, we're receiving one string with all the data.
     // 0 - RPM
@@ -141,17 +413,19 @@ void SensorConvert::processData(QString data)
     // 14 - OAT
     // 15 - IAT
 
-    convertRpm(data.section(',',0,0).toDouble());
-    convertFuelFlow(data.section(',',1,1).toDouble());
-    convertOilTemp(data.section(',',2,2).toDouble());
-    convertOilPress(data.section(',',3,3).toDouble());
-    //convertAmperage(data.section(',',4,4).toDouble());
-    //convertVolts(data.section(',',5,5).toDouble());
-    convertEgt(data.section(',',6,6).toDouble(),data.section(',',7,7).toDouble(),data.section(',',8,8).toDouble(),data.section(',',9,9).toDouble());
-    convertCht(data.section(',',10,10).toDouble(),data.section(',',11,11).toDouble(),data.section(',',12,12).toDouble(),data.section(',',13,13).toDouble());
-    convertOat(data.section(',',14,14).toDouble());
-    convertIat(data.section(',',15,15).toDouble());
-
-    emit updateMonitor(rpm, fuelFlow, oilTemp, oilPress, amps, volts, egt1, egt2, egt3, egt4, cht1, cht2, cht3, cht4, oat, iat);
+    sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+    convertRpm(field[0]);
+    convertFuelFlow(field[1]);
+    convertOilTemp(field[2]);
+    convertOilPress(field[3]);
+    //convertAmperage(field[4]);
+    //convertVolts(field[5]);
+    convertEgt(field[6], field[7], field[8], field[9]);
+    convertCht(field[10], field[11], field[12], field[13]);
+    convertOat(field[14]);
+    convertIat(field[15]);
+
+    emit sampleConverted(sample);
+    emit updateMonitor(sample);
 }
 
@@ -12,6 +12,12 @@
 
 #include <QtCore>
 #include <math.h>
+#include "rdacconnect.h"
+#include "arduinoparser.h"
+#include "enginesample.h"
+#include "thermocouple.h"
+#include "calibration.h"
+#include "units.h"
 
 //! Sensor Convert Class
 /*!
@@ -23,17 +29,42 @@ class SensorConvert : public QThread
     Q_OBJECT
 public:
     explicit SensorConvert(QObject *parent = 0);
+    void setRdacSampleQueue(RDACsampleQueue *queue);
 
 private:
     QSettings settings;
     QSettings gaugeSettings;
     QString thermocoupleTypeCht;
     QString thermocoupleTypeEgt;
-    QString temperatureScale;
+    TemperatureUnit temperatureUnit;
+    PressureUnit pressureUnit;
+    VolumeUnit fuelUnit;
+    VolumeUnit fuelFlowUnit;
+    RDACsampleQueue *rdacSamples;
+    ArduinoParser arduinoParser;
+    bool binaryInterface;
+    QTimer drainTimer;
 
     qreal kFactor;
+    qreal fuelFlowScale;
 
-    qreal rpm, fuelFlow, oilTemp, oilPress, amps, volts, egt1, egt2, egt3, egt4, cht1, cht2, cht3, cht4, oat, iat;
+    EngineSample sample;
+
+    // Sender reading to value, a channel without a valid curve is never shown
+    CalibrationCurve calibration[ChannelCount];
+    qreal oilTempPullup;
+
+    ThermocoupleTable egtTable;
+    ThermocoupleTable chtTable;
+    qreal thermocoupleScale;
+
+    void loadCalibration(EngineChannel channel, QString name, const CalibrationCurve &fallback = CalibrationCurve());
+    bool convertCalibrated(EngineChannel channel, double input);
+    void convertCurveToDisplay(EngineChannel channel, TemperatureUnit unit);
+    void convertCurveToDisplay(EngineChannel channel, PressureUnit unit);
+    void convertCurveToDisplay(EngineChannel channel, VolumeUnit unit);
+    void convertRdacMessage1(const RDACsample &rdacSample);
+    void convertSensorFields(const qreal *field);
 
     void setThermocoupleTypeCht(QString type); // K or J
     void setThermocoupleTypeEgt(QString type); // K or J
@@ -42,6 +73,8 @@ private:
 
     void convertEgt(double volt1, double volt2, double volt3, double volt4);
     void convertCht(double volt1, double volt2, double volt3, double volt4);
+    void convertThermocouples(const qreal *microvolts, const EngineChannel *channels, int count, const ThermocoupleTable &table);
+    Celsius coldJunctionTemperature() const;
 
     void convertIat(double sensorValue);
 
@@ -54,17 +87,18 @@ private:
 
     void convertRpm(double pulses);
 
-    double convertTemperature(double temp);
+    void convertVolts(double voltage);
 
     void setKFactor(qreal kFac);
 
 signals:
     void userMessage(QString,QString,bool);
-    void updateMonitor(qreal rpm, qreal fuelFlow, qreal oilTemp, qreal oilPress, qreal amps, qreal volts, qreal egt1, qreal egt2, qreal egt3, qreal egt4, qreal cht1, qreal cht2, qreal cht3, qreal cht4, qreal oat, qreal iat);
+    void sampleConverted(const EngineSample &sample);
+    void updateMonitor(const EngineSample &sample);
 
 public slots:
-    void processData(QString data);
-    void onRdacUpdate(qreal fuelFlowPulses, qreal volts);
+    void processData(const QByteArray &data);
+    void drainRdacSamples();
 };
 
 #endif // SENSORCONVERT_H
@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <QtCore>
+
+//! SPSC Queue Class
+/*!
+ * A bounded, lock-free queue between exactly one producer thread and one consumer thread.
+ * Items are copied by value, so T should be a plain data type. When the queue is full push()
+ * fails instead of blocking the producer.
+*/
+
+template <typename T, int Capacity>
+class SpscQueue
+{
+	Q_STATIC_ASSERT_X(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	SpscQueue() : head(0), tail(0) {}
+
+	//! Producer side. Returns false if the queue is full and the item was not queued.
+	bool push(const T &item)
+	{
+		const quint32 currentTail = tail.load();
+		if(currentTail - head.loadAcquire() == quint32(Capacity))
+		{
+			return false;
+		}
+		items[currentTail & (Capacity - 1)] = item;
+		tail.storeRelease(currentTail + 1);
+		return true;
+	}
+
+	//! Consumer side. Returns false if there was nothing to take.
+	bool pop(T &item)
+	{
+		const quint32 currentHead = head.load();
+		if(currentHead == tail.loadAcquire())
+		{
+			return false;
+		}
+		item = items[currentHead & (Capacity - 1)];
+		head.storeRelease(currentHead + 1);
+		return true;
+	}
+
+	int size() const
+	{
+		return int(tail.loadAcquire() - head.loadAcquire());
+	}
+
+	static int capacity()
+	{
+		return Capacity;
+	}
+
+private:
+	T items[Capacity];
+	QAtomicInteger<quint32> head; // Only written by the consumer
+	QAtomicInteger<quint32> tail; // Only written by the producer
+};
+
+#endif // SPSCQUEUE_H
@@ -19,6 +19,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "textBoxGauge.h"
+#include "paintprofiler.h"
 
 TextBox::TextBox(QGraphicsObject *parent)
 	: QGraphicsObject(parent)
@@ -44,6 +45,7 @@ QRectF TextBox::boundingRect() const
 */
 void TextBox::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+	PaintProfiler::Scope profile(this);
 	Q_UNUSED(option);
 	Q_UNUSED(widget);
 
@@ -98,6 +100,9 @@ void TextBox::setPrecision(quint8 readout, quint8 bar)
 
 void TextBox::setValue(double value)
 {
-	currentValue = value;
-	update();
+	if(value != currentValue)
+	{
+		currentValue = value;
+		update();
+	}
 }
@@ -0,0 +1,154 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "thermocouple.h"
+#include <math.h>
+
+// NIST ITS-90 reference functions, EMF in mV for temperatures in degree C
+static const qreal typeKBelowZero[] = {
+	0.0, 0.394501280250E-01, 0.236223735980E-04, -0.328589067840E-06, -0.499048287770E-08,
+	-0.675090591730E-10, -0.574103274280E-12, -0.310888728940E-14, -0.104516093650E-16,
+	-0.198892668780E-19, -0.163226974860E-22
+};
+static const qreal typeKAboveZero[] = {
+	-0.176004136860E-01, 0.389212049750E-01, 0.185587700320E-04, -0.994575928740E-07,
+	0.318409457190E-09, -0.560728448890E-12, 0.560750590590E-15, -0.320207200030E-18,
+	0.971511471520E-22, -0.121047212750E-25
+};
+static const qreal typeKExponential[] = {0.118597600000E+00, -0.118343200000E-03, 0.126968600000E+03};
+static const qreal typeJBelow760[] = {
+	0.0, 0.503811878150E-01, 0.304758369300E-04, -0.856810657200E-07, 0.132281952950E-09,
+	-0.170529583370E-12, 0.209480906970E-15, -0.125383953360E-18, 0.156317256970E-22
+};
+static const qreal typeJAbove760[] = {
+	0.296456256810E+03, -0.149761277860E+01, 0.317871039240E-02, -0.318476867010E-05,
+	0.157208190040E-08, -0.306913690560E-12
+};
+
+// Resolution of the inverse table, the error of interpolating within 10 uV is far below 0.1 degree
+static const qreal emfStep = 10.0;
+
+template <int N> static qreal polynomial(const qreal (&c)[N], qreal x)
+{
+	qreal result = c[N - 1];
+	for(int i = N - 2; i >= 0; --i)
+	{
+		result = result * x + c[i];
+	}
+	return result;
+}
+
+ThermocoupleTable::ThermocoupleTable(Type type) : outputConversion(identityConversion)
+{
+	setType(type);
+}
+
+/*! \brief Makes convert() produce temperatures in another unit than degree C
+*/
+void ThermocoupleTable::setOutputConversion(const UnitConversion &conversion)
+{
+	outputConversion = conversion;
+	setType(thermocoupleType);
+}
+
+/*! \brief Returns the reference EMF in microvolts
+*/
+qreal ThermocoupleTable::referenceEmf(Type type, qreal celsius)
+{
+	qreal millivolts;
+	if(type == TypeK)
+	{
+		if(celsius < 0.0)
+		{
+			millivolts = polynomial(typeKBelowZero, celsius);
+		}
+		else
+		{
+			const qreal offset = celsius - typeKExponential[2];
+			millivolts = polynomial(typeKAboveZero, celsius) + typeKExponential[0] * exp(typeKExponential[1] * offset * offset);
+		}
+	}
+	else
+	{
+		millivolts = celsius < 760.0 ? polynomial(typeJBelow760, celsius) : polynomial(typeJAbove760, celsius);
+	}
+	return millivolts * 1000.0;
+}
+
+/*! \brief Fills both lookup tables for the given thermocouple type
+*/
+void ThermocoupleTable::setType(Type type)
+{
+	thermocoupleType = type;
+	minTemperature = type == TypeK ? -200 : -210;
+	const int maxTemperature = type == TypeK ? 1372 : 1200;
+
+	emfTable.resize(maxTemperature - minTemperature + 1);
+	for(int i = 0; i < emfTable.size(); ++i)
+	{
+		emfTable[i] = referenceEmf(type, minTemperature + i);
+	}
+
+	// The reference functions are strictly increasing, so the inverse is found in one sweep
+	minEmf = emfTable.first();
+	inverseEmfStep = 1.0 / emfStep;
+	temperatureTable.resize(int((emfTable.last() - minEmf) / emfStep) + 1);
+	int degree = 0;
+	for(int i = 0; i < temperatureTable.size(); ++i)
+	{
+		const qreal emf = minEmf + i * emfStep;
+		while(degree < emfTable.size() - 2 && emfTable.at(degree + 1) < emf)
+		{
+			++degree;
+		}
+		const qreal fraction = (emf - emfTable.at(degree)) / (emfTable.at(degree + 1) - emfTable.at(degree));
+		temperatureTable[i] = outputConversion.apply(minTemperature + degree + fraction);
+	}
+}
+
+/*! \brief Returns the EMF in microvolts the thermocouple produces at the given temperature
+* against a 0 degree C reference junction
+*/
+qreal ThermocoupleTable::emfAt(qreal celsius) const
+{
+	const qreal position = qBound(0.0, celsius - minTemperature, qreal(emfTable.size() - 1));
+	const int index = qMin(int(position), emfTable.size() - 2);
+	return emfTable.at(index) + (emfTable.at(index + 1) - emfTable.at(index)) * (position - index);
+}
+
+/*! \brief Converts count measured thermocouple voltages to temperatures in the output unit
+*
+* The cold junction temperature is added as EMF before the inverse lookup. Readings outside
+* the range of the thermocouple are clamped to its ends.
+*/
+void ThermocoupleTable::convert(const qreal *microvolts, qreal *temperatures, int count, Celsius coldJunction) const
+{
+	const qreal offset = emfAt(coldJunction.value) - minEmf;
+	const qreal *table = temperatureTable.constData();
+	const qreal lastPosition = temperatureTable.size() - 1;
+	const int lastIndex = temperatureTable.size() - 2;
+
+	for(int i = 0; i < count; ++i)
+	{
+		const qreal position = qBound(0.0, (microvolts[i] + offset) * inverseEmfStep, lastPosition);
+		const int index = qMin(int(position), lastIndex);
+		temperatures[i] = table[index] + (table[index + 1] - table[index]) * (position - index);
+	}
+}
@@ -0,0 +1,59 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef THERMOCOUPLE_H
+#define THERMOCOUPLE_H
+
+#include <QtCore>
+#include "units.h"
+
+//! Thermocouple Table Class
+/*!
+ * This class linearizes K and J type thermocouples. The NIST ITS-90 reference polynomials are
+ * only evaluated once, to fill a table of the EMF at every whole degree and an inverse table of
+ * the temperature at evenly spaced EMF steps. Converting a reading is then a cold junction
+ * lookup plus one linear interpolation per channel.
+*/
+
+class ThermocoupleTable
+{
+public:
+	enum Type {
+		TypeK,
+		TypeJ
+	};
+	explicit ThermocoupleTable(Type type = TypeK);
+	void setType(Type type);
+	void setOutputConversion(const UnitConversion &conversion);
+	Type type() const {return thermocoupleType;}
+	qreal emfAt(qreal celsius) const;
+	void convert(const qreal *microvolts, qreal *temperatures, int count, Celsius coldJunction) const;
+private:
+	Type thermocoupleType;
+	UnitConversion outputConversion;
+	int minTemperature;
+	QVector<qreal> emfTable; // Microvolts at minTemperature + index degree C
+	qreal minEmf;
+	qreal inverseEmfStep;
+	QVector<qreal> temperatureTable; // Output unit at minEmf + index / inverseEmfStep microvolts
+	static qreal referenceEmf(Type type, qreal celsius);
+};
+
+#endif // THERMOCOUPLE_H
@@ -0,0 +1,169 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <QtCore>
+
+#include "flightlog.h"
+
+// Leading columns of the former EngineData CSV, HOBBS, FLIGHT and MARK follow them. Channels
+// the old log did not have are appended after MARK, so existing parsers keep working.
+static const char *const legacyColumns[] = {
+	"EGT1", "EGT2", "EGT3", "EGT4", "CHT1", "CHT2", "CHT3", "CHT4",
+	"OILT", "OILP", "OAT", "IAT", "BAT", "CUR", "RPM", "MAP", "FF"
+};
+
+// Header keys of the log and their labels in the former CSV
+static const char *const legacyHeader[][2] = {
+	{"callSign", "Call Sign"},
+	{"aircraftModel", "Aircraft Model"},
+	{"aircraftSerial", "Aircraft S/N"},
+	{"engineType", "Engine Type"},
+	{"engineSerial", "Engine S/N"}
+};
+
+/*! \brief Formats seconds as hh:mm:ss like the hour meter
+*/
+static QString formatTime(quint32 seconds)
+{
+	return QString("%1:%2:%3").arg(seconds / 3600, 2, 10, QChar('0')).arg(seconds / 60 % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+static int findChannel(const FlightLogReader &reader, const QString &name)
+{
+	for(int i = 0; i < reader.channelCount(); ++i)
+	{
+		if(reader.channelName(i) == name)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Writes the log in the layout of the former EngineData CSV: a [Header] section, a [data]
+// section and one row per sample, empty fields for channels without a value.
+int main(int argc, char *argv[])
+{
+	QCoreApplication a(argc, argv);
+	const QStringList arguments = a.arguments();
+	if(arguments.size() < 2)
+	{
+		qCritical() << "Usage: flightlogexport <log> [csv]";
+		return 2;
+	}
+
+	FlightLogReader reader;
+	if(!reader.open(arguments.at(1)))
+	{
+		qCritical() << arguments.at(1) << reader.errorString();
+		return 1;
+	}
+
+	const QString outputName = arguments.size() > 2 ? arguments.at(2) : QFileInfo(arguments.at(1)).completeBaseName().append(".csv");
+	QFile output(outputName);
+	if(!output.open(QIODevice::WriteOnly))
+	{
+		qCritical() << outputName << output.errorString();
+		return 1;
+	}
+	QTextStream out(&output);
+	out.setCodec("UTF-8");
+
+	// Log channel index of every CSV column, -1 for a legacy channel missing in the log
+	const int legacyCount = int(sizeof(legacyColumns) / sizeof(legacyColumns[0]));
+	QVector<int> leading;
+	QVector<int> trailing;
+	for(int i = 0; i < legacyCount; ++i)
+	{
+		leading << findChannel(reader, legacyColumns[i]);
+	}
+	for(int i = 0; i < reader.channelCount(); ++i)
+	{
+		if(!leading.contains(i))
+		{
+			trailing << i;
+		}
+	}
+
+	out << "[Header]\r\n";
+	out << "Created with Cardinal EMS - " << reader.headerValue("created") << "\r\n";
+	for(unsigned i = 0; i < sizeof(legacyHeader) / sizeof(legacyHeader[0]); ++i)
+	{
+		out << legacyHeader[i][1] << ": " << reader.headerValue(legacyHeader[i][0]) << "\r\n";
+	}
+	out << "Hobbs at start: " << reader.headerValue("hobbs") << "\r\n";
+	const int oilTemp = findChannel(reader, "OILT");
+	const int oilPress = findChannel(reader, "OILP");
+	const int fuelFlow = findChannel(reader, "FF");
+	out << QString("All temperatures in degree %1\r\n oil pressure in %2\r\n fuel flow in %3.\r\n").arg(oilTemp < 0 ? QString() : reader.channelUnit(oilTemp), oilPress < 0 ? QString() : reader.channelUnit(oilPress), fuelFlow < 0 ? QString() : reader.channelUnit(fuelFlow));
+	QStringList units;
+	for(int i = 0; i < reader.channelCount(); ++i)
+	{
+		units << QString("%1=%2").arg(reader.channelName(i), reader.channelUnit(i));
+	}
+	out << "Units: " << units.join(';') << "\r\n";
+	out << "[data]\r\n";
+	out << "INDEX;TIME";
+	for(int i = 0; i < legacyCount; ++i)
+	{
+		out << ';' << legacyColumns[i];
+	}
+	out << ";HOBBS;FLIGHT;MARK";
+	foreach(int channel, trailing)
+	{
+		out << ';' << reader.channelName(channel);
+	}
+	out << "\r\n";
+
+	quint64 index = 0;
+	EngineSample sample;
+	quint32 hobbsSeconds;
+	quint32 flightSeconds;
+	while(reader.next(&sample, &hobbsSeconds, &flightSeconds))
+	{
+		out << index++ << ';' << QDateTime::fromMSecsSinceEpoch(sample.timestamp, Qt::UTC).toString("yyyy-MM-dd hh:mm:ss.zzz");
+		foreach(int channel, leading)
+		{
+			out << ';';
+			const int engineChannel = channel < 0 ? -1 : reader.engineChannel(channel);
+			if(engineChannel >= 0 && sample.isValid(EngineChannel(engineChannel)))
+			{
+				out << QString::number(sample.value[engineChannel], 'g', 7);
+			}
+		}
+		out << ';' << formatTime(hobbsSeconds) << ';' << formatTime(flightSeconds) << ';';
+		foreach(int channel, trailing)
+		{
+			out << ';';
+			const int engineChannel = reader.engineChannel(channel);
+			if(engineChannel >= 0 && sample.isValid(EngineChannel(engineChannel)))
+			{
+				out << QString::number(sample.value[engineChannel], 'g', 7);
+			}
+		}
+		out << "\r\n";
+	}
+
+	if(!reader.errorString().isEmpty())
+	{
+		qWarning() << "Stopped after" << index << "samples:" << reader.errorString();
+	}
+	return 0;
+}
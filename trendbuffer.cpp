@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "trendbuffer.h"
+#include <cmath>
+
+TrendBuffer::TrendBuffer(int bucketCount, qreal width) : head(0)
+  , count(0)
+  , width(width)
+{
+	setResolution(bucketCount, width);
+}
+
+/*! \brief Sets the number of buckets and their width, this drops the stored trend
+*/
+void TrendBuffer::setResolution(int bucketCount, qreal width)
+{
+	buckets.resize(qMax(bucketCount, 1));
+	this->width = width > 0.0 ? width : 1.0;
+	clear();
+}
+
+void TrendBuffer::clear()
+{
+	head = 0;
+	count = 0;
+}
+
+/*! \brief Merges the sample into its bucket, starting a new bucket and dropping the oldest if needed
+*
+* Keys are expected to increase; a key before the newest bucket is merged into that bucket.
+*/
+void TrendBuffer::add(qreal key, qreal value)
+{
+	const qreal start = std::floor(key / width) * width;
+	if(count && start <= last().start)
+	{
+		TrendBucket &bucket = buckets[(head + count - 1) % buckets.size()];
+		bucket.minimum = qMin(bucket.minimum, value);
+		bucket.maximum = qMax(bucket.maximum, value);
+		bucket.sum += value;
+		++bucket.count;
+		return;
+	}
+
+	if(count == buckets.size())
+	{
+		head = (head + 1) % buckets.size();
+		--count;
+	}
+	TrendBucket &bucket = buckets[(head + count) % buckets.size()];
+	bucket.start = start;
+	bucket.minimum = value;
+	bucket.maximum = value;
+	bucket.sum = value;
+	bucket.count = 1;
+	++count;
+}
@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef TRENDBUFFER_H
+#define TRENDBUFFER_H
+
+#include <QtCore>
+
+//! Trend Bucket
+/*!
+ * All samples of one channel whose key falls into [start, start + bucket width).
+*/
+
+struct TrendBucket
+{
+	qreal start;
+	qreal minimum;
+	qreal maximum;
+	qreal sum;
+	int count;
+	qreal mean() const {return count ? sum / count : 0.0;}
+};
+
+//! Trend Buffer Class
+/*!
+ * A fixed number of buckets of one channel in a ring, oldest first. Samples are merged into the
+ * bucket their key falls into, so each bucket keeps the minimum and maximum of its interval
+ * however many samples arrived. With one bucket per pixel column the envelope of the buckets
+ * is all a plot needs to draw, and memory and drawing cost do not grow with the flight.
+*/
+
+class TrendBuffer
+{
+public:
+	explicit TrendBuffer(int bucketCount = 0, qreal width = 1.0);
+	void setResolution(int bucketCount, qreal width);
+	int capacity() const {return buckets.size();}
+	qreal bucketWidth() const {return width;}
+	void add(qreal key, qreal value);
+	void clear();
+	int size() const {return count;}
+	const TrendBucket &at(int index) const {return buckets.at((head + index) % buckets.size());}
+	const TrendBucket &last() const {return at(count - 1);}
+private:
+	QVector<TrendBucket> buckets;
+	int head;
+	int count;
+	qreal width; // Key units per bucket
+};
+
+#endif // TRENDBUFFER_H
@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "trendpyramid.h"
+
+TrendPyramid::TrendPyramid()
+{
+	for(int channel = 0; channel < ChannelCount; ++channel)
+	{
+		for(int index = 0; index < levelCount; ++index)
+		{
+			levels[channel][index].setResolution(levelCapacity, levelWidth(index));
+		}
+	}
+}
+
+/*! \brief Returns the bucket width of a level in seconds
+*/
+qreal TrendPyramid::levelWidth(int index)
+{
+	static const qreal widths[levelCount] = {1.0, 10.0, 60.0, 600.0};
+	return widths[qBound(0, index, int(levelCount) - 1)];
+}
+
+/*! \brief Merges the valid channels of the sample into every level, key is in seconds
+*/
+void TrendPyramid::add(qreal key, const EngineSample &sample)
+{
+	for(int channel = 0; channel < ChannelCount; ++channel)
+	{
+		if(!sample.isValid(EngineChannel(channel)))
+		{
+			continue;
+		}
+		for(int index = 0; index < levelCount; ++index)
+		{
+			levels[channel][index].add(key, sample.value[channel]);
+		}
+	}
+}
+
+void TrendPyramid::clear()
+{
+	for(int channel = 0; channel < ChannelCount; ++channel)
+	{
+		for(int index = 0; index < levelCount; ++index)
+		{
+			levels[channel][index].clear();
+		}
+	}
+}
+
+/*! \brief Returns the finest level that covers span seconds in at most columns buckets
+*
+* Spans longer than the coarsest level holds return the coarsest level.
+*/
+int TrendPyramid::levelFor(qreal span, int columns) const
+{
+	for(int index = 0; index < levelCount - 1; ++index)
+	{
+		const qreal buckets = span / levelWidth(index);
+		if(buckets <= columns && buckets <= levelCapacity)
+		{
+			return index;
+		}
+	}
+	return levelCount - 1;
+}
@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef TRENDPYRAMID_H
+#define TRENDPYRAMID_H
+
+#include <QtCore>
+#include "enginesample.h"
+#include "trendbuffer.h"
+
+//! Trend Pyramid Class
+/*!
+ * The history of every engine channel at four resolutions: 1 s, 10 s, 1 min and 10 min buckets,
+ * each level holding levelCapacity buckets. Every sample is merged into all levels of its
+ * valid channels as it arrives. A view picks the finest level that covers its time span with
+ * no more buckets than it has columns, so showing two minutes or the whole flight costs the
+ * same.
+*/
+
+class TrendPyramid
+{
+public:
+	enum {
+		levelCount = 4,
+		levelCapacity = 720 // 12 minutes at 1 s up to 5 days at 10 min
+	};
+	TrendPyramid();
+	void add(qreal key, const EngineSample &sample);
+	void clear();
+	const TrendBuffer &level(EngineChannel channel, int index) const {return levels[channel][index];}
+	int levelFor(qreal span, int columns) const;
+	static qreal levelWidth(int index);
+private:
+	TrendBuffer levels[ChannelCount][levelCount];
+};
+
+#endif // TRENDPYRAMID_H
@@ -0,0 +1,146 @@
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EngineMonitor, a graphical gauge to monitor an aircraft's engine     //
+// Copyright (C) 2017 Ryan Story                                        //
+//                                                                      //
+// This program is free software: you can redistribute it and/or modify //
+// it under the terms of the GNU General Public License as published by //
+// the Free Software Foundation, either version 3 of the License, or    //
+// (at your option) any later version.                                  //
+//                                                                      //
+// This program is distributed in the hope that it will be useful,      //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of       //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        //
+// GNU General Public License for more details.                         //
+//                                                                      //
+// You should have received a copy of the GNU General Public License    //
+// along with this program. If not, see <http://www.gnu.org/licenses/>. //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef UNITS_H
+#define UNITS_H
+
+#include <QtCore>
+
+//! Units
+/*!
+ * Every supported unit converts to the base unit of its dimension (degree C, bar, liter) with
+ * a scale and an offset, so any conversion is a single multiply-add. Conversions between fixed
+ * units are constant expressions; conversions into the display unit chosen in the settings are
+ * built once and folded into the calibration and thermocouple tables.
+ * Fuel flow is a volume per hour and uses the volume units.
+*/
+
+enum TemperatureUnit {
+	TemperatureCelsius,
+	TemperatureFahrenheit,
+	TemperatureKelvin,
+	TemperatureRankine
+};
+
+enum PressureUnit {
+	PressureBar,
+	PressurePsi,
+	PressureKiloPascal,
+	PressureInchHg
+};
+
+enum VolumeUnit {
+	VolumeLiter,
+	VolumeUsGallon,
+	VolumeImperialGallon
+};
+
+struct UnitConversion
+{
+	qreal scale;
+	qreal offset;
+	Q_DECL_CONSTEXPR qreal apply(qreal value) const {return value * scale + offset;}
+	Q_DECL_CONSTEXPR UnitConversion then(const UnitConversion &next) const {return UnitConversion{scale * next.scale, offset * next.scale + next.offset};}
+	Q_DECL_CONSTEXPR UnitConversion inverse() const {return UnitConversion{1.0 / scale, -offset / scale};}
+};
+
+static Q_DECL_CONSTEXPR UnitConversion identityConversion = {1.0, 0.0};
+
+// Conversion from each unit into the base unit of its dimension
+inline Q_DECL_CONSTEXPR UnitConversion toBaseUnit(TemperatureUnit unit)
+{
+	return unit == TemperatureFahrenheit ? UnitConversion{5.0 / 9.0, -32.0 * 5.0 / 9.0}
+		: unit == TemperatureKelvin ? UnitConversion{1.0, -273.15}
+		: unit == TemperatureRankine ? UnitConversion{5.0 / 9.0, -273.15}
+		: identityConversion;
+}
+
+inline Q_DECL_CONSTEXPR UnitConversion toBaseUnit(PressureUnit unit)
+{
+	return unit == PressurePsi ? UnitConversion{0.0689475729, 0.0}
+		: unit == PressureKiloPascal ? UnitConversion{0.01, 0.0}
+		: unit == PressureInchHg ? UnitConversion{0.0338638866, 0.0}
+		: identityConversion;
+}
+
+inline Q_DECL_CONSTEXPR UnitConversion toBaseUnit(VolumeUnit unit)
+{
+	return unit == VolumeUsGallon ? UnitConversion{3.785411784, 0.0}
+		: unit == VolumeImperialGallon ? UnitConversion{4.54609, 0.0}
+		: identityConversion;
+}
+
+template <typename Unit> inline Q_DECL_CONSTEXPR UnitConversion unitConversion(Unit from, Unit to)
+{
+	return toBaseUnit(from).then(toBaseUnit(to).inverse());
+}
+
+//! Quantity
+/*!
+ * A value tagged with its unit, e.g. Quantity<TemperatureUnit, TemperatureCelsius>. Mixing up
+ * units is a compile error and to<>() is evaluated at compile time for constant values.
+*/
+
+template <typename Unit, Unit U> struct Quantity
+{
+	Q_DECL_CONSTEXPR explicit Quantity(qreal v) : value(v) {}
+	template <Unit To> Q_DECL_CONSTEXPR Quantity<Unit, To> to() const {return Quantity<Unit, To>(unitConversion(U, To).apply(value));}
+	qreal value;
+};
+
+typedef Quantity<TemperatureUnit, TemperatureCelsius> Celsius;
+typedef Quantity<PressureUnit, PressureBar> Bar;
+typedef Quantity<VolumeUnit, VolumeLiter> Liter;
+
+// Units as written in the settings, e.g. Units/temp=F, Units/pressure=PSI, Units/fuel=GAL
+inline TemperatureUnit temperatureUnitFromString(const QString &unit)
+{
+	const QString u = unit.trimmed().toUpper();
+	return u == "F" ? TemperatureFahrenheit : u == "K" ? TemperatureKelvin : u == "R" ? TemperatureRankine : TemperatureCelsius;
+}
+
+inline PressureUnit pressureUnitFromString(const QString &unit)
+{
+	const QString u = unit.trimmed().toUpper();
+	return u == "PSI" ? PressurePsi : u == "KPA" ? PressureKiloPascal : u == "INHG" ? PressureInchHg : PressureBar;
+}
+
+inline VolumeUnit volumeUnitFromString(const QString &unit)
+{
+	const QString u = unit.trimmed().toUpper();
+	if(u.startsWith("GAL") || u == "GPH")
+	{
+		return VolumeUsGallon;
+	}
+	return u.startsWith("IMP") ? VolumeImperialGallon : VolumeLiter;
+}
+
+inline QString unitLabel(TemperatureUnit unit)
+{
+	return unit == TemperatureFahrenheit ? QString::fromUtf8("°F")
+		: unit == TemperatureKelvin ? QString("K")
+		: unit == TemperatureRankine ? QString::fromUtf8("°R")
+		: QString::fromUtf8("°C");
+}
+
+Q_STATIC_ASSERT(unitConversion(TemperatureCelsius, TemperatureFahrenheit).apply(100.0) > 211.99
+				&& unitConversion(TemperatureCelsius, TemperatureFahrenheit).apply(100.0) < 212.01);
+
+#endif // UNITS_H
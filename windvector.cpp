@@ -19,6 +19,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "windvector.h"
+#include "paintprofiler.h"
 
 WindVector::WindVector(QGraphicsObject *parent) : QGraphicsObject(parent)
 {
@@ -39,6 +40,8 @@ QRectF WindVector::boundingRect() const
 
 void WindVector::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *)
 {
+    PaintProfiler::Scope profile(this);
+
     //Set Clipping Rect
     painter->setClipRect(boundingRect());
 